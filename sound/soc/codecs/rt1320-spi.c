@@ -25,6 +25,15 @@
 #include <linux/pm_qos.h>
 #include <linux/sysfs.h>
 #include <linux/clk.h>
+#include <linux/completion.h>
+#include <linux/ktime.h>
+#include <linux/spinlock.h>
+#include <linux/mutex.h>
+#include <linux/list.h>
+#include <linux/property.h>
+#include <linux/debugfs.h>
+#include <linux/mm.h>
+#include <linux/sched/task_stack.h>
 #include <sound/core.h>
 #include <sound/pcm.h>
 #include <sound/pcm_params.h>
@@ -33,18 +42,46 @@
 #include <sound/initval.h>
 #include <sound/tlv.h>
 
-#include "rt1320-spi-3.h"
+#include "rt1320-spi.h"
 
-static struct spi_device *rt1320_spi;
+/*
+ * One instance per SPI companion. Each codec resolves its own companion
+ * through the "realtek,spi-companion" reference (DT phandle or ACPI _DSD),
+ * so several amps can stream firmware in parallel.
+ */
+struct rt1320_spi {
+	struct spi_device *spi;
+	struct rt1320_spi_slot *slots;
+	struct mutex lock; /* serialises bursts on the slots */
+	struct list_head list;
+	struct dentry *debugfs;
+
+	/*
+	 * Burst chunk size. chunk_max is what the controller and the board
+	 * allow; chunk is only used once rt1320_spi_selftest() has read it
+	 * back correctly, RT1320_SPI_BUF_LEN is used until then.
+	 */
+	unsigned int chunk;
+	unsigned int chunk_max;
+	bool verified;
+
+	/* DMA-safe buffer for the 32-bit commands, under lock */
+	u8 xbuf[16] ____cacheline_aligned;
+};
+
+static LIST_HEAD(rt1320_spi_list);
+static DEFINE_MUTEX(rt1320_spi_list_lock);
 
-int rt1320_spi_read_addr(unsigned int addr, unsigned int *val)
+int rt1320_spi_read_addr(struct rt1320_spi *rspi, unsigned int addr, unsigned int *val)
 {
 	struct spi_message message;
 	struct spi_transfer x[3];
 	u8 spi_cmd = RT1320_SPI_CMD_32_READ;
 	int status;
-	u8 write_buf[5];
-	u8 read_buf[4];
+	u8 *write_buf = rspi->xbuf;
+	u8 *read_buf = rspi->xbuf + 8;
+
+	mutex_lock(&rspi->lock);
 
 	write_buf[0] = spi_cmd;
 	write_buf[1] = (addr & 0x000000ff) >> 0;
@@ -67,19 +104,23 @@ int rt1320_spi_read_addr(unsigned int addr, unsigned int *val)
 	x[2].rx_buf = read_buf;
 	spi_message_add_tail(&x[2], &message);
 
-	status = spi_sync(rt1320_spi, &message);
+	status = spi_sync(rspi->spi, &message);
 
 	*val = read_buf[0] | read_buf[1] << 8 | read_buf[2] << 16 |
 		read_buf[3] << 24;
 
+	mutex_unlock(&rspi->lock);
+
 	return status;
 }
 
-int rt1320_spi_write_addr(unsigned int addr, unsigned int val)
+int rt1320_spi_write_addr(struct rt1320_spi *rspi, unsigned int addr, unsigned int val)
 {
 	u8 spi_cmd = RT1320_SPI_CMD_32_WRITE;
 	int status;
-	u8 write_buf[10];
+	u8 *write_buf = rspi->xbuf;
+
+	mutex_lock(&rspi->lock);
 
 	write_buf[0] = spi_cmd;
 	write_buf[1] = (addr & 0x000000ff) >> 0;
@@ -92,123 +133,520 @@ int rt1320_spi_write_addr(unsigned int addr, unsigned int val)
 	write_buf[8] = (val & 0xff000000) >> 24;
 	write_buf[9] = spi_cmd;
 
-	status = spi_write(rt1320_spi, write_buf, sizeof(write_buf));
+	status = spi_write(rspi->spi, write_buf, 10);
+	mutex_unlock(&rspi->lock);
 
 	if (status)
-		dev_err(&rt1320_spi->dev, "%s error %d\n", __func__, status);
+		dev_err(&rspi->spi->dev, "%s error %d\n", __func__, status);
 
 	return status;
 }
 
-int rt1320_spi_burst_read(u32 addr, u8 *rxbuf, size_t len)
-{
-	u8 spi_cmd = RT1320_SPI_CMD_BURST_READ;
-	int status;
-	u8 write_buf[8];
-	unsigned int end, offset = 0;
+/*
+ * Burst engine. A burst is split into chunks of rt1320_spi.chunk bytes
+ * (RT1320_SPI_BUF_LEN until the self-test has passed), each sent
+ * as its own spi_message. RT1320_SPI_INFLIGHT messages are queued with
+ * spi_async() at a time; the completion of one chunk refills its slot with
+ * the next chunk, and the last completion wakes the caller.
+ *
+ * Write chunks are sent without copying the payload: the header and the
+ * padding come from small DMA-safe buffers in the slot and the payload
+ * transfer points straight into the caller's buffer. Only payloads that
+ * cannot be mapped for DMA (e.g. on the stack) go through the bounce
+ * buffer.
+ */
+#define RT1320_SPI_INFLIGHT	4
+#define RT1320_SPI_CHUNK_MAX	4096
+/* header plus the worst case write padding (7 bytes + 1 trailing byte) */
+#define RT1320_SPI_OVERHEAD	(5 + 8)
+
+struct rt1320_spi_burst;
 
+struct rt1320_spi_slot {
 	struct spi_message message;
 	struct spi_transfer x[3];
+	struct rt1320_spi_burst *burst;
 
-	while (offset < len) {
-		if (offset + RT1320_SPI_BUF_LEN <= len)
-			end = RT1320_SPI_BUF_LEN;
-		else
-			end = len % RT1320_SPI_BUF_LEN;
+	/* DMA-safe buffers, kept on their own cache lines */
+	u8 hdr[8] ____cacheline_aligned;
+	u8 pad[8] ____cacheline_aligned;
+	u8 *bounce; /* chunk_max bytes */
+};
 
-		write_buf[0] = spi_cmd;
-		write_buf[1] = ((addr + offset) & 0x000000ff) >> 0;
-		write_buf[2] = ((addr + offset) & 0x0000ff00) >> 8;
-		write_buf[3] = ((addr + offset) & 0x00ff0000) >> 16;
-		write_buf[4] = ((addr + offset) & 0xff000000) >> 24;
+struct rt1320_spi_burst {
+	struct rt1320_spi *rspi;
+	struct spi_device *spi;
+	bool write;
+	bool bounce;
+	u32 addr;
+	const u8 *txbuf;
+	u8 *rxbuf;
+	size_t len;
+	unsigned int chunk;
+	unsigned int chunks;
+	unsigned int next;
+	unsigned int active;
+	int status;
+	spinlock_t lock;
+	struct completion done;
+};
 
-		spi_message_init(&message);
-		memset(x, 0, sizeof(x));
+static void rt1320_spi_burst_complete(void *context);
 
-		x[0].len = 5;
-		x[0].tx_buf = write_buf;
-		spi_message_add_tail(&x[0], &message);
+static bool rt1320_spi_dma_safe(const void *buf)
+{
+	if (object_is_on_stack(buf))
+		return false;
 
-		x[1].len = 4;
-		x[1].tx_buf = write_buf;
-		spi_message_add_tail(&x[1], &message);
+	return virt_addr_valid(buf) || is_vmalloc_addr(buf);
+}
 
-		x[2].len = end;
-		x[2].rx_buf = rxbuf + offset;
-		spi_message_add_tail(&x[2], &message);
+static void rt1320_spi_burst_prep(struct rt1320_spi_burst *burst,
+	struct rt1320_spi_slot *slot, unsigned int idx)
+{
+	unsigned int offset = idx * burst->chunk;
+	unsigned int end = min_t(size_t, burst->chunk, burst->len - offset);
+	u32 addr = burst->addr + offset;
+	u8 *hdr = slot->hdr;
+
+	hdr[0] = burst->write ? RT1320_SPI_CMD_BURST_WRITE : RT1320_SPI_CMD_BURST_READ;
+	hdr[1] = (addr & 0x000000ff) >> 0;
+	hdr[2] = (addr & 0x0000ff00) >> 8;
+	hdr[3] = (addr & 0x00ff0000) >> 16;
+	hdr[4] = (addr & 0xff000000) >> 24;
+
+	spi_message_init(&slot->message);
+	slot->message.complete = rt1320_spi_burst_complete;
+	slot->message.context = slot;
+	memset(slot->x, 0, sizeof(slot->x));
+
+	slot->x[0].len = 5;
+	slot->x[0].tx_buf = hdr;
+	spi_message_add_tail(&slot->x[0], &slot->message);
+
+	if (burst->write) {
+		if (burst->bounce) {
+			memcpy(slot->bounce, &burst->txbuf[offset], end);
+			slot->x[1].tx_buf = slot->bounce;
+		} else {
+			slot->x[1].tx_buf = &burst->txbuf[offset];
+		}
+		slot->x[1].len = end;
+		spi_message_add_tail(&slot->x[1], &slot->message);
+
+		/* the chip takes whole 8-byte words plus one trailing byte */
+		slot->x[2].len = round_up(end, 8) - end + 1;
+		slot->x[2].tx_buf = slot->pad;
+		spi_message_add_tail(&slot->x[2], &slot->message);
+	} else {
+		slot->x[1].len = 4;
+		slot->x[1].tx_buf = hdr;
+		spi_message_add_tail(&slot->x[1], &slot->message);
+
+		slot->x[2].len = end;
+		slot->x[2].rx_buf = burst->rxbuf + offset;
+		spi_message_add_tail(&slot->x[2], &slot->message);
+	}
+}
 
-		status = spi_sync(rt1320_spi, &message);
+static void rt1320_spi_burst_complete(void *context)
+{
+	struct rt1320_spi_slot *slot = context;
+	struct rt1320_spi_burst *burst = slot->burst;
+	unsigned long flags;
+	bool submit = false, last = false;
+	int ret;
 
-		if (status)
-			return false;
+	spin_lock_irqsave(&burst->lock, flags);
+	if (slot->message.status && !burst->status)
+		burst->status = slot->message.status;
 
-		offset += RT1320_SPI_BUF_LEN;
+	if (!burst->status && burst->next < burst->chunks) {
+		rt1320_spi_burst_prep(burst, slot, burst->next++);
+		submit = true;
+	} else {
+		last = !--burst->active;
+	}
+	spin_unlock_irqrestore(&burst->lock, flags);
+
+	if (submit) {
+		ret = spi_async(burst->spi, &slot->message);
+		if (ret) {
+			spin_lock_irqsave(&burst->lock, flags);
+			if (!burst->status)
+				burst->status = ret;
+			last = !--burst->active;
+			spin_unlock_irqrestore(&burst->lock, flags);
+		}
 	}
 
-	return 0;
+	if (last)
+		complete(&burst->done);
+}
+
+static int rt1320_spi_burst(struct rt1320_spi_burst *burst)
+{
+	struct rt1320_spi_slot *slots;
+	unsigned int i, nslots;
+	unsigned long flags;
+	ktime_t start = ktime_get();
+	s64 us;
+	int ret;
+
+	if (!burst->rspi)
+		return -ENODEV;
+
+	burst->spi = burst->rspi->spi;
+	slots = burst->rspi->slots;
+
+	if (!burst->len)
+		return 0;
+
+	if (burst->write)
+		burst->bounce = !rt1320_spi_dma_safe(burst->txbuf);
+
+	mutex_lock(&burst->rspi->lock);
+
+	if (!burst->chunk)
+		burst->chunk = burst->rspi->verified ?
+			burst->rspi->chunk : RT1320_SPI_BUF_LEN;
+	burst->chunks = DIV_ROUND_UP(burst->len, burst->chunk);
+	nslots = min_t(unsigned int, burst->chunks, RT1320_SPI_INFLIGHT);
+
+	spin_lock_init(&burst->lock);
+	init_completion(&burst->done);
+	burst->next = nslots;
+	burst->active = nslots;
+	burst->status = 0;
+
+	for (i = 0; i < nslots; i++) {
+		slots[i].burst = burst;
+		rt1320_spi_burst_prep(burst, &slots[i], i);
+	}
+
+	for (i = 0; i < nslots; i++) {
+		ret = spi_async(burst->spi, &slots[i].message);
+		if (ret) {
+			/* stop refilling, and drop the slots never queued */
+			spin_lock_irqsave(&burst->lock, flags);
+			if (!burst->status)
+				burst->status = ret;
+			burst->active -= nslots - i;
+			if (!burst->active)
+				complete(&burst->done);
+			spin_unlock_irqrestore(&burst->lock, flags);
+			break;
+		}
+	}
+
+	wait_for_completion(&burst->done);
+	mutex_unlock(&burst->rspi->lock);
+
+	us = ktime_us_delta(ktime_get(), start);
+	dev_dbg(&burst->spi->dev, "%s %zu bytes at 0x%08x in %lld us (%lld KB/s)\n",
+		burst->write ? "write" : "read", burst->len, burst->addr, us,
+		us ? div_s64((s64)burst->len * 1000, us) : 0);
+
+	return burst->status;
+}
+
+int rt1320_spi_burst_read(struct rt1320_spi *rspi, u32 addr, u8 *rxbuf, size_t len)
+{
+	struct rt1320_spi_burst burst = {
+		.rspi = rspi,
+		.write = false,
+		.addr = addr,
+		.rxbuf = rxbuf,
+		.len = len,
+	};
+
+	return rt1320_spi_burst(&burst);
 }
 
 /**
  * rt1320_spi_burst_write - Write data to SPI by rt1320 address.
+ * @rspi: SPI companion of the codec.
  * @addr: Start address.
  * @txbuf: Data Buffer for writng.
  * @len: Data length.
  *
  *
- * Returns true for success.
+ * Returns 0 for success.
  */
-int rt1320_spi_burst_write(u32 addr, const u8 *txbuf, size_t len)
+int rt1320_spi_burst_write(struct rt1320_spi *rspi, u32 addr, const u8 *txbuf, size_t len)
 {
-	u8 spi_cmd = RT1320_SPI_CMD_BURST_WRITE;
-	u8 *write_buf;
-	unsigned int end, offset = 0;
+	struct rt1320_spi_burst burst = {
+		.rspi = rspi,
+		.write = true,
+		.addr = addr,
+		.txbuf = txbuf,
+		.len = len,
+	};
+
+	return rt1320_spi_burst(&burst);
+}
 
-	write_buf = kmalloc(RT1320_SPI_BUF_LEN + 6, GFP_KERNEL);
+int rt1320_spi_burst_write_exp(struct rt1320_spi *rspi, const u8 *txbuf, unsigned int end)
+{
+	int ret;
 
-	while (offset < len) {
-		if (offset + RT1320_SPI_BUF_LEN <= len)
-			end = RT1320_SPI_BUF_LEN;
-		else
-			end = len % RT1320_SPI_BUF_LEN;
+	ret = spi_write(rspi->spi, txbuf, end + 6);
 
-		write_buf[0] = spi_cmd;
-		write_buf[1] = ((addr + offset) & 0x000000ff) >> 0;
-		write_buf[2] = ((addr + offset) & 0x0000ff00) >> 8;
-		write_buf[3] = ((addr + offset) & 0x00ff0000) >> 16;
-		write_buf[4] = ((addr + offset) & 0xff000000) >> 24;
+	return ret;
+}
 
-		memcpy(&write_buf[5], &txbuf[offset], end);
+/**
+ * rt1320_spi_selftest - Verify the burst chunk size against the chip.
+ * @rspi: SPI companion of the codec.
+ * @addr: Start of a scratch area that the caller is about to overwrite
+ *        (e.g. a firmware segment).
+ * @size: Size of the scratch area. Nothing past it is touched.
+ *
+ * Writes a pattern with the configured chunk size and reads it back,
+ * halving the chunk on each mismatch until it reads back correctly or
+ * reaches RT1320_SPI_BUF_LEN. The pattern spans two chunks, so chunks
+ * larger than about half of @size cannot be verified and are not used.
+ * Does nothing once a chunk size is verified.
+ *
+ * Returns 0 for success, or the SPI error, leaving the chunk unverified.
+ */
+int rt1320_spi_selftest(struct rt1320_spi *rspi, u32 addr, unsigned int size)
+{
+	struct device *dev = &rspi->spi->dev;
+	unsigned int chunk, i, len;
+	u8 *tx, *rx;
+	int ret = 0;
+
+	mutex_lock(&rspi->lock);
+	chunk = rspi->chunk;
+	if (rspi->verified) {
+		mutex_unlock(&rspi->lock);
+		return 0;
+	}
+	mutex_unlock(&rspi->lock);
 
-		if (end % 8)
-			end = (end / 8 + 1) * 8;
+	chunk = min_t(unsigned int, chunk, round_down((size + 8) / 2, 8));
+	chunk = max_t(unsigned int, chunk, RT1320_SPI_BUF_LEN);
 
-		spi_write(rt1320_spi, write_buf, end + 6);
+	len = 2 * chunk - 8;
+	tx = kmalloc(len, GFP_KERNEL);
+	rx = kmalloc(len, GFP_KERNEL);
+	if (!tx || !rx) {
+		ret = -ENOMEM;
+		goto _exit_;
+	}
 
-		offset += RT1320_SPI_BUF_LEN;
+	for (i = 0; i < len; i++)
+		tx[i] = (i * 0x5b) ^ (i >> 8);
+
+	while (chunk > RT1320_SPI_BUF_LEN) {
+		/* two chunks plus a tail, so chunk boundaries are covered */
+		struct rt1320_spi_burst wr = {
+			.rspi = rspi, .write = true, .addr = addr,
+			.txbuf = tx, .len = 2 * chunk - 8, .chunk = chunk,
+		};
+		struct rt1320_spi_burst rd = {
+			.rspi = rspi, .write = false, .addr = addr,
+			.rxbuf = rx, .len = 2 * chunk - 8, .chunk = chunk,
+		};
+
+		memset(rx, 0, wr.len);
+		ret = rt1320_spi_burst(&wr);
+		if (!ret)
+			ret = rt1320_spi_burst(&rd);
+		if (ret) {
+			dev_err(dev, "%s: %u byte chunks: SPI error %d\n",
+				__func__, chunk, ret);
+			goto _exit_;
+		}
+		if (!memcmp(tx, rx, wr.len))
+			break;
+
+		dev_dbg(dev, "%s: %u byte chunks read back wrong, retrying\n",
+			__func__, chunk);
+		chunk = max_t(unsigned int, round_down(chunk / 2, 8),
+			RT1320_SPI_BUF_LEN);
 	}
 
-	kfree(write_buf);
+	mutex_lock(&rspi->lock);
+	rspi->chunk = chunk;
+	rspi->verified = true;
+	mutex_unlock(&rspi->lock);
+
+	dev_info(dev, "burst chunk size %u bytes\n", chunk);
+
+_exit_:
+	kfree(tx);
+	kfree(rx);
+
+	return ret;
+}
+
+/*
+ * The largest chunk the controller takes in one message, optionally
+ * lowered by the "realtek,spi-burst-len" property for boards with
+ * marginal signal integrity.
+ */
+static unsigned int rt1320_spi_chunk_limit(struct spi_device *spi)
+{
+	size_t limit = RT1320_SPI_CHUNK_MAX;
+	u32 prop;
+
+	if (!device_property_read_u32(&spi->dev, "realtek,spi-burst-len", &prop))
+		limit = min_t(size_t, limit, prop);
+
+	limit = min(limit, spi_max_transfer_size(spi));
+	if (spi_max_message_size(spi) > RT1320_SPI_OVERHEAD)
+		limit = min(limit, spi_max_message_size(spi) - RT1320_SPI_OVERHEAD);
+
+	return max_t(unsigned int, round_down(limit, 8), RT1320_SPI_BUF_LEN);
+}
+
+#ifdef CONFIG_DEBUG_FS
+static int rt1320_spi_burst_len_get(void *data, u64 *val)
+{
+	struct rt1320_spi *rspi = data;
+
+	*val = rspi->verified ? rspi->chunk : RT1320_SPI_BUF_LEN;
 
 	return 0;
 }
 
-int rt1320_spi_burst_write_exp(const u8 *txbuf,unsigned int end)
+/* A new size is used once it has passed the self-test at the next load */
+static int rt1320_spi_burst_len_set(void *data, u64 val)
 {
-	int ret;
+	struct rt1320_spi *rspi = data;
 
-	ret = spi_write(rt1320_spi, txbuf, end + 6);
+	if (val < RT1320_SPI_BUF_LEN || val > rspi->chunk_max)
+		return -EINVAL;
 
-	return ret;
+	mutex_lock(&rspi->lock);
+	rspi->chunk = round_down(val, 8);
+	rspi->verified = rspi->chunk == RT1320_SPI_BUF_LEN;
+	mutex_unlock(&rspi->lock);
+
+	return 0;
+}
+DEFINE_DEBUGFS_ATTRIBUTE(rt1320_spi_burst_len_fops, rt1320_spi_burst_len_get,
+	rt1320_spi_burst_len_set, "%llu\n");
+
+static void rt1320_spi_debugfs_init(struct rt1320_spi *rspi)
+{
+	rspi->debugfs = debugfs_create_dir(dev_name(&rspi->spi->dev), NULL);
+	debugfs_create_file("burst_len", 0644, rspi->debugfs, rspi,
+		&rt1320_spi_burst_len_fops);
+	debugfs_create_u32("burst_len_max", 0444, rspi->debugfs,
+		&rspi->chunk_max);
+}
+#else
+static inline void rt1320_spi_debugfs_init(struct rt1320_spi *rspi)
+{
+}
+#endif
+
+/**
+ * rt1320_spi_get - Find the SPI companion of a codec.
+ * @dev: The codec device.
+ *
+ * The companion is named by the "realtek,spi-companion" reference of @dev.
+ * Without the reference, a single probed companion is used, as on boards
+ * with one amp.
+ *
+ * Returns the companion, NULL if there is none, or -EPROBE_DEFER if the
+ * referenced companion has not probed yet. Release it with rt1320_spi_put().
+ */
+struct rt1320_spi *rt1320_spi_get(struct device *dev)
+{
+	struct fwnode_handle *fwnode;
+	struct rt1320_spi *rspi, *found = NULL;
+	int count = 0;
+
+	fwnode = fwnode_find_reference(dev_fwnode(dev), "realtek,spi-companion", 0);
+	if (IS_ERR(fwnode))
+		fwnode = NULL;
+
+	mutex_lock(&rt1320_spi_list_lock);
+	list_for_each_entry(rspi, &rt1320_spi_list, list) {
+		if (fwnode && dev_fwnode(&rspi->spi->dev) != fwnode)
+			continue;
+		found = rspi;
+		count++;
+	}
+	if (count != 1)
+		found = NULL;
+	if (found) {
+		/* unbinding the companion unbinds the codec first */
+		if (!device_link_add(dev, &found->spi->dev, DL_FLAG_AUTOREMOVE_CONSUMER))
+			dev_warn(dev, "Failed to link to %s\n", dev_name(&found->spi->dev));
+		get_device(&found->spi->dev);
+	}
+	mutex_unlock(&rt1320_spi_list_lock);
+
+	if (fwnode) {
+		fwnode_handle_put(fwnode);
+		if (!found)
+			return ERR_PTR(-EPROBE_DEFER);
+	}
+
+	return found;
+}
+
+void rt1320_spi_put(struct rt1320_spi *rspi)
+{
+	if (rspi)
+		put_device(&rspi->spi->dev);
 }
 
 static int rt1320_spi_probe(struct spi_device *spi)
 {
-	pr_info("rt1320_spi_probe is probed!\n");
-	rt1320_spi = spi;
+	struct rt1320_spi *rspi;
+	int i;
+
+	dev_dbg(&spi->dev, "%s\n", __func__);
+
+	rspi = devm_kzalloc(&spi->dev, sizeof(*rspi), GFP_KERNEL);
+	if (!rspi)
+		return -ENOMEM;
+
+	rspi->chunk_max = rt1320_spi_chunk_limit(spi);
+	rspi->chunk = rspi->chunk_max;
+	rspi->verified = rspi->chunk == RT1320_SPI_BUF_LEN;
+
+	rspi->slots = devm_kcalloc(&spi->dev, RT1320_SPI_INFLIGHT,
+		sizeof(*rspi->slots), GFP_KERNEL);
+	if (!rspi->slots)
+		return -ENOMEM;
+
+	for (i = 0; i < RT1320_SPI_INFLIGHT; i++) {
+		rspi->slots[i].bounce = devm_kmalloc(&spi->dev, rspi->chunk_max,
+			GFP_KERNEL);
+		if (!rspi->slots[i].bounce)
+			return -ENOMEM;
+	}
+
+	rspi->spi = spi;
+	mutex_init(&rspi->lock);
+	spi_set_drvdata(spi, rspi);
+	rt1320_spi_debugfs_init(rspi);
+
+	mutex_lock(&rt1320_spi_list_lock);
+	list_add_tail(&rspi->list, &rt1320_spi_list);
+	mutex_unlock(&rt1320_spi_list_lock);
 
 	return 0;
 }
 
+static void rt1320_spi_remove(struct spi_device *spi)
+{
+	struct rt1320_spi *rspi = spi_get_drvdata(spi);
+
+	mutex_lock(&rt1320_spi_list_lock);
+	list_del(&rspi->list);
+	mutex_unlock(&rt1320_spi_list_lock);
+
+	debugfs_remove_recursive(rspi->debugfs);
+}
+
 static const struct of_device_id rt1320_of_match[] = {
 	{ .compatible = "realtek,rt1320-spi", },
 	{},
@@ -221,6 +659,7 @@ static struct spi_driver rt1320_spi_driver = {
 		.of_match_table = of_match_ptr(rt1320_of_match),
 	},
 	.probe = rt1320_spi_probe,
+	.remove = rt1320_spi_remove,
 };
 module_spi_driver(rt1320_spi_driver);
 
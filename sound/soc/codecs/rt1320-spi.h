@@ -24,10 +24,15 @@ enum {
 	RT1320_SPI_CMD_BURST_WRITE,
 };
 
-int rt1320_spi_burst_write(u32 addr, const u8 *txbuf, size_t len);
-int rt1320_spi_burst_read(u32 addr, u8 *rxbuf, size_t len);
-int rt1320_spi_burst_write_exp(const u8 *txbuf,unsigned int end);
-int rt1320_spi_read_addr(unsigned int addr, unsigned int *val);
-int rt1320_spi_write_addr(unsigned int addr, unsigned int val);
+struct rt1320_spi;
+
+struct rt1320_spi *rt1320_spi_get(struct device *dev);
+void rt1320_spi_put(struct rt1320_spi *rspi);
+int rt1320_spi_burst_write(struct rt1320_spi *rspi, u32 addr, const u8 *txbuf, size_t len);
+int rt1320_spi_burst_read(struct rt1320_spi *rspi, u32 addr, u8 *rxbuf, size_t len);
+int rt1320_spi_burst_write_exp(struct rt1320_spi *rspi, const u8 *txbuf, unsigned int end);
+int rt1320_spi_selftest(struct rt1320_spi *rspi, u32 addr, unsigned int size);
+int rt1320_spi_read_addr(struct rt1320_spi *rspi, unsigned int addr, unsigned int *val);
+int rt1320_spi_write_addr(struct rt1320_spi *rspi, unsigned int addr, unsigned int val);
 
 #endif /* __RT1320_SPI_H__ */
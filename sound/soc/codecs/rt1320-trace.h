@@ -0,0 +1,193 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * rt1320-trace.h  --  ALC1320 tracepoints
+ *
+ * Copyright 2025 Realtek Semiconductor Corp.
+ *
+ * The header is included from this directory, so the object needs
+ *
+ *   CFLAGS_rt1320.o := -I$(src)
+ */
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM rt1320
+
+#if !defined(__RT1320_TRACE_H__) || defined(TRACE_HEADER_MULTI_READ)
+#define __RT1320_TRACE_H__
+
+#include <linux/device.h>
+#include <linux/math64.h>
+#include <linux/tracepoint.h>
+#include <sound/soc-dapm.h>
+
+TRACE_EVENT(rt1320_reg_io,
+	TP_PROTO(struct device *dev, bool write, bool spi, unsigned int reg,
+		const u8 *val, size_t len),
+	TP_ARGS(dev, write, spi, reg, val, len),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(bool, write)
+		__field(bool, spi)
+		__field(unsigned int, reg)
+		__field(unsigned int, len)
+		__field(u8, val)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->write = write;
+		__entry->spi = spi;
+		__entry->reg = reg;
+		__entry->len = len;
+		__entry->val = len ? val[0] : 0;
+	),
+	TP_printk("%s %s %s reg=0x%08x len=%u val=0x%02x", __get_str(name),
+		__entry->write ? "write" : "read", __entry->spi ? "spi" : "i2c",
+		__entry->reg, __entry->len, __entry->val)
+);
+
+TRACE_EVENT(rt1320_mbox,
+	TP_PROTO(struct device *dev, unsigned int cmd, unsigned int param_id,
+		const u8 *param, unsigned int size, s64 us, int ret),
+	TP_ARGS(dev, cmd, param_id, param, size, us, ret),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(unsigned int, cmd)
+		__field(unsigned int, param_id)
+		__field(unsigned int, size)
+		__field(s64, us)
+		__field(int, ret)
+		__dynamic_array(u8, param, size)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->cmd = cmd;
+		__entry->param_id = param_id;
+		__entry->size = size;
+		__entry->us = us;
+		__entry->ret = ret;
+		memcpy(__get_dynamic_array(param), param, size);
+	),
+	TP_printk("%s cmd=%u id=0x%02x size=%u %lld us ret=%d param=%s",
+		__get_str(name), __entry->cmd, __entry->param_id, __entry->size,
+		__entry->us, __entry->ret,
+		__print_hex(__get_dynamic_array(param), __entry->size))
+);
+
+TRACE_EVENT(rt1320_fw_seg_start,
+	TP_PROTO(struct device *dev, const char *fw, unsigned int addr, size_t size),
+	TP_ARGS(dev, fw, addr, size),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__string(fw, fw)
+		__field(unsigned int, addr)
+		__field(size_t, size)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__assign_str(fw, fw);
+		__entry->addr = addr;
+		__entry->size = size;
+	),
+	TP_printk("%s %s addr=0x%08x size=%zu", __get_str(name), __get_str(fw),
+		__entry->addr, __entry->size)
+);
+
+TRACE_EVENT(rt1320_fw_seg_end,
+	TP_PROTO(struct device *dev, const char *fw, unsigned int addr, size_t size,
+		s64 us),
+	TP_ARGS(dev, fw, addr, size, us),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__string(fw, fw)
+		__field(unsigned int, addr)
+		__field(size_t, size)
+		__field(s64, us)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__assign_str(fw, fw);
+		__entry->addr = addr;
+		__entry->size = size;
+		__entry->us = us;
+	),
+	TP_printk("%s %s addr=0x%08x size=%zu %lld us (%lld KB/s)", __get_str(name),
+		__get_str(fw), __entry->addr, __entry->size, __entry->us,
+		__entry->us ? div_s64((s64)__entry->size * 1000, __entry->us) : 0)
+);
+
+TRACE_EVENT(rt1320_mcu_patch,
+	TP_PROTO(struct device *dev, const char *fw, u32 crc, size_t size,
+		unsigned int xfers, s64 us, bool skipped, int ret),
+	TP_ARGS(dev, fw, crc, size, xfers, us, skipped, ret),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__string(fw, fw)
+		__field(u32, crc)
+		__field(size_t, size)
+		__field(unsigned int, xfers)
+		__field(s64, us)
+		__field(bool, skipped)
+		__field(int, ret)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__assign_str(fw, fw);
+		__entry->crc = crc;
+		__entry->size = size;
+		__entry->xfers = xfers;
+		__entry->us = us;
+		__entry->skipped = skipped;
+		__entry->ret = ret;
+	),
+	TP_printk("%s %s crc=0x%08x %zu bytes in %u transfers %lld us%s ret=%d",
+		__get_str(name), __get_str(fw), __entry->crc, __entry->size,
+		__entry->xfers, __entry->us,
+		__entry->skipped ? " (already loaded)" : "", __entry->ret)
+);
+
+TRACE_EVENT(rt1320_calib,
+	TP_PROTO(struct device *dev, const char *phase, int ch, int ret),
+	TP_ARGS(dev, phase, ch, ret),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__string(phase, phase)
+		__field(int, ch)
+		__field(int, ret)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__assign_str(phase, phase);
+		__entry->ch = ch;
+		__entry->ret = ret;
+	),
+	TP_printk("%s %s ch=%d ret=%d", __get_str(name), __get_str(phase),
+		__entry->ch, __entry->ret)
+);
+
+TRACE_EVENT(rt1320_pdb,
+	TP_PROTO(struct device *dev, int event, s64 us),
+	TP_ARGS(dev, event, us),
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(int, event)
+		__field(s64, us)
+	),
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->event = event;
+		__entry->us = us;
+	),
+	TP_printk("%s %s %lld us", __get_str(name),
+		__print_symbolic(__entry->event,
+			{ SND_SOC_DAPM_PRE_PMU, "PRE_PMU" },
+			{ SND_SOC_DAPM_POST_PMD, "POST_PMD" }),
+		__entry->us)
+);
+
+#endif /* __RT1320_TRACE_H__ */
+
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE rt1320-trace
+#include <trace/define_trace.h>
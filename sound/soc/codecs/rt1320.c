@@ -26,16 +26,28 @@
 #include <sound/initval.h>
 #include <sound/tlv.h>
 #include <linux/math64.h>
+#include <linux/ktime.h>
+#include <linux/completion.h>
+#include <linux/workqueue.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/bitmap.h>
+#include <linux/crc32.h>
+#include <linux/bsearch.h>
+#include <linux/jump_label.h>
+#include <linux/rcupdate.h>
+#include <linux/vmalloc.h>
+#include <asm/unaligned.h>
 #include "rt1320.h"
 #include "rt1320-sdw.h"
 #include "rt1320-spi.h"
-#include "rt1320_bind_write_333_20.h"
+#include "rt1320_bind_write_333_20_packed.h"
+
+#define CREATE_TRACE_POINTS
+#include "rt1320-trace.h"
 
 // #define RT1320_I2C_FW_WR
 // #define RT1320_I2C_FW_RD
-struct file *log_fp = NULL;
-const char *log_path = "/lib/firmware/rt1320_boot.log";
-loff_t log_pos = 0;
 
 static const struct reg_default rt1320_regs[] = {
 	{ 0x00000100, 0 },
@@ -105,144 +117,178 @@ static const struct reg_default rt1320_regs[] = {
 	{ 0x0000e825, 0x7f },
 };
 
-static bool rt1320_readable_register(struct device *dev, unsigned int reg)
+/*
+ * Register access map, sorted by address and non-overlapping. Registers
+ * outside the map are write-only. The regmap predicates and the register
+ * dumpers are all derived from it.
+ *
+ * Only the control space (0x0000..0xffff) is cached. Everything above it
+ * is MCU, patch or DSP memory that is written once and read back through
+ * the bus, so it is treated as volatile and never enters the cache.
+ */
+#define RT1320_CTRL_MAX		0xffff
+
+#define RT1320_REG_RD		BIT(0)
+#define RT1320_REG_VOL		BIT(1)
+
+struct rt1320_reg_range {
+	unsigned int min;
+	unsigned int max;
+	unsigned int flags;
+};
+
+static const struct rt1320_reg_range rt1320_reg_ranges[] = {
+	{ 0x00000100, 0x00000100, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c000, 0x0000c000, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c003, 0x0000c003, RT1320_REG_RD },
+	{ 0x0000c019, 0x0000c01b, RT1320_REG_RD },
+	{ 0x0000c040, 0x0000c043, RT1320_REG_RD },
+	{ 0x0000c044, 0x0000c044, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c045, 0x0000c047, RT1320_REG_RD },
+	{ 0x0000c054, 0x0000c054, RT1320_REG_RD },
+	{ 0x0000c057, 0x0000c057, RT1320_REG_RD },
+	{ 0x0000c081, 0x0000c081, RT1320_REG_RD },
+	{ 0x0000c084, 0x0000c086, RT1320_REG_RD },
+	{ 0x0000c400, 0x0000c40b, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c480, 0x0000c483, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c484, 0x0000c48b, RT1320_REG_RD },
+	{ 0x0000c48c, 0x0000c48f, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c560, 0x0000c560, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c570, 0x0000c570, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c58c, 0x0000c58d, RT1320_REG_RD },
+	{ 0x0000c5c0, 0x0000c5c4, RT1320_REG_RD },
+	{ 0x0000c5c8, 0x0000c5c8, RT1320_REG_RD },
+	{ 0x0000c5d3, 0x0000c5d3, RT1320_REG_RD },
+	{ 0x0000c5fb, 0x0000c5fb, RT1320_REG_RD },
+	{ 0x0000c600, 0x0000c601, RT1320_REG_RD },
+	{ 0x0000c604, 0x0000c604, RT1320_REG_RD },
+	{ 0x0000c609, 0x0000c609, RT1320_REG_RD },
+	{ 0x0000c680, 0x0000c680, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c700, 0x0000c701, RT1320_REG_RD },
+	{ 0x0000c900, 0x0000c900, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000c901, 0x0000c901, RT1320_REG_RD },
+	{ 0x0000ca05, 0x0000ca05, RT1320_REG_RD },
+	{ 0x0000ca07, 0x0000ca07, RT1320_REG_RD },
+	{ 0x0000ca25, 0x0000ca25, RT1320_REG_RD },
+	{ 0x0000ca27, 0x0000ca27, RT1320_REG_RD },
+	{ 0x0000cc10, 0x0000cc10, RT1320_REG_RD },
+	{ 0x0000cd00, 0x0000cd00, RT1320_REG_RD },
+	{ 0x0000cf02, 0x0000cf02, RT1320_REG_RD },
+	{ 0x0000d470, 0x0000d471, RT1320_REG_RD },
+	{ 0x0000d474, 0x0000d475, RT1320_REG_RD },
+	{ 0x0000d478, 0x0000d47a, RT1320_REG_RD },
+	{ 0x0000d486, 0x0000d487, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000dd08, 0x0000dd0b, RT1320_REG_RD },
+	{ 0x0000de03, 0x0000de03, RT1320_REG_RD },
+	{ 0x0000e802, 0x0000e803, RT1320_REG_RD },
+	{ 0x0000e824, 0x0000e825, RT1320_REG_RD },
+	{ 0x0000f015, 0x0000f015, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000f01c, 0x0000f01f, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x0000f080, 0x0000f084, RT1320_REG_RD },
+	{ 0x10007000, 0x10007fff, RT1320_REG_RD | RT1320_REG_VOL }, // MCU patch area
+	{ 0x1000cd91, 0x1000cd96, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x1000f008, 0x1000f008, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x1000f021, 0x1000f021, RT1320_REG_RD | RT1320_REG_VOL },
+	{ 0x3fc00000, 0x3fe3b000, RT1320_REG_RD | RT1320_REG_VOL }, // DSP Memory
+};
+
+static int rt1320_reg_range_cmp(const void *key, const void *elt)
 {
-	switch (reg) {
-	case 0x00000100:
-	case 0x0000c000:
-	case 0x0000c003:
-	case 0x0000c019:
-	case 0x0000c01a:
-	case 0x0000c01b:
-	case 0x0000c040:
-	case 0x0000c041:
-	case 0x0000c042:
-	case 0x0000c043:
-	case 0x0000c044:
-	case 0x0000c045:
-	case 0x0000c046:
-	case 0x0000c047:
-	case 0x0000c054:
-	case 0x0000c057:
-	case 0x0000c081:
-	case 0x0000c084:
-	case 0x0000c085:
-	case 0x0000c086:
-	case 0x0000c400 ... 0x0000c40b:
-	case 0x0000c480 ... 0x0000c48f:
-	case 0x0000c560:
-	case 0x0000c570:
-	case 0x0000c58c:
-	case 0x0000c58d:
-	case 0x0000c5c0:
-	case 0x0000c5c1:
-	case 0x0000c5c2:
-	case 0x0000c5c3:
-	case 0x0000c5c4:
-	case 0x0000c5c8:
-	case 0x0000c5d3:
-	case 0x0000c5fb:
-	case 0x0000c600:
-	case 0x0000c601:
-	case 0x0000c604:
-	case 0x0000c609:
-	case 0x0000c680:
-	case 0x0000c700:
-	case 0x0000c701:
-	case 0x0000c900:
-	case 0x0000c901:
-	case 0x0000ca05:
-	case 0x0000ca07:
-	case 0x0000ca25:
-	case 0x0000ca27:
-	case 0x0000cc10:
-	case 0x0000cd00:
-	case 0x0000cf02:
-	case 0x0000d470:
-	case 0x0000d471:
-	case 0x0000d474:
-	case 0x0000d475:
-	case 0x0000d478:
-	case 0x0000d479:
-	case 0x0000d47a:
-	case 0x0000d486:
-	case 0x0000d487:
-	case 0x0000dd08 ... 0x0000dd0b:
-	case 0x0000de03:
-	case 0x0000e802:
-	case 0x0000e803:
-	case 0x0000e824:
-	case 0x0000e825:
-	case 0x0000f080:
-	case 0x0000f081:
-	case 0x0000f082:
-	case 0x0000f083:
-	case 0x0000f084:
-	case 0x0000f015:
-	case 0x0000f01c ... 0x0000f01f:
-	case 0x1000cd91 ... 0x1000cd96:
-	case 0x1000f008:
-	case 0x1000f021:
-#if 0
-	case 0x3fc000c0 ... 0x3fc01110:
-	case 0x3fc2ab80 ... 0x3fc2abd4:
-	case 0x3fc2bf80 ... 0x3fc2bf83:
-	case 0x3fc2bfc0 ... 0x3fc2bfc7:
-	case 0x3fe2e000 ... 0x3fe2e003:
-#else
-	case 0x3fc00000 ... 0x3fe3b000: // DSP Memory
-#endif
-		return true;
-	default:
-		break;
-	}
+	unsigned int reg = *(const unsigned int *)key;
+	const struct rt1320_reg_range *range = elt;
+
+	if (reg < range->min)
+		return -1;
+	if (reg > range->max)
+		return 1;
+
+	return 0;
+}
+
+static unsigned int rt1320_reg_flags(unsigned int reg)
+{
+	const struct rt1320_reg_range *range;
+
+	range = bsearch(&reg, rt1320_reg_ranges, ARRAY_SIZE(rt1320_reg_ranges),
+		sizeof(*range), rt1320_reg_range_cmp);
 
-	return false;
+	return range ? range->flags : 0;
+}
+
+static bool rt1320_readable_register(struct device *dev, unsigned int reg)
+{
+	return rt1320_reg_flags(reg) & RT1320_REG_RD;
 }
 
 static bool rt1320_volatile_register(struct device *dev, unsigned int reg)
 {
-	switch (reg) {
-	case 0x00000100:
-	case 0x0000c000:
-	case 0x0000c044:
-	case 0x0000c400 ... 0x0000c40b:
-	case 0x0000c480 ... 0x0000c483:
-	case 0x0000c48c ... 0x0000c48f:
-	case 0x0000c560:
-	case 0x0000c570:
-	case 0x0000c680:
-	case 0x0000c900:
-	case 0x0000d486:
-	case 0x0000d487:
-	case 0x1000cd91 ... 0x1000cd96:
-	case 0x1000f008:
-	case 0x0000f015:
-	case 0x1000f021:
-	case 0x0000f01c ... 0x0000f01f:
-#if 0
-	case 0x3fc000c0 ... 0x3fc01110:
-	case 0x3fc29d80 ... 0x3fc2a254:
-	case 0x3fc2ab80 ... 0x3fc2abd4:
-	case 0x3fc2b780 ... 0x3fc2bdac:
-	case 0x3fc2bf80 ... 0x3fc2bf83:
-	case 0x3fc2bfc0 ... 0x3fc2bfc7:
-	case 0x3fe00000 ... 0x3fe01ed4:
-	case 0x3fe02000 ... 0x3fe0def0:
-	case 0x3fe2e000 ... 0x3fe2e003:
-#else
-	case 0x3fc00000 ... 0x3fe3b000: // DSP Memory
-#endif
+	if (reg > RT1320_CTRL_MAX)
 		return true;
-	default:
+
+	return rt1320_reg_flags(reg) & RT1320_REG_VOL;
+}
+
+/*
+ * Write a run of consecutive registers as one auto-increment transfer.
+ * The register bus picks the transport, see rt1320_bus_use_spi().
+ */
+static int rt1320_bulk_write(struct rt1320_priv *rt1320, unsigned int reg,
+	const u8 *vals, size_t len)
+{
+	if (len == 1)
+		return regmap_write(rt1320->regmap, reg, vals[0]);
+
+	return regmap_raw_write(rt1320->regmap, reg, vals, len);
+}
+
+/* MCU patch code area */
+#define RT1320_MCU_PATCH_BASE	0x10007000
+#define RT1320_MCU_PATCH_SIZE	0x1000
+
+/*
+ * A patch file may end with a signature record: the address word is
+ * RT1320_MCU_PATCH_SIG_ID and the value word is the address of a 4-byte
+ * slot in the patch window that the patch leaves unpopulated for it. The
+ * CRC32 of the other records is written to the slot, little endian, after
+ * the patch, and the slot is cleared before the first byte of a new load.
+ * The load is skipped when the slot already holds the CRC, a reset that
+ * clears the patch RAM clears the slot as well. Files without the record
+ * are always loaded.
+ */
+#define RT1320_MCU_PATCH_SIG_ID		0x50534947 /* "PSIG" */
+#define RT1320_MCU_PATCH_SIG_LEN	4
+
+static bool force_mcu_patch;
+module_param(force_mcu_patch, bool, 0644);
+MODULE_PARM_DESC(force_mcu_patch, "Always reload the MCU patch, even if the device holds it already");
+
+static bool rt1320_mcu_patch_loaded(struct rt1320_priv *rt1320,
+	unsigned int sig_addr, u32 crc)
+{
+	u8 buf[RT1320_MCU_PATCH_SIG_LEN];
+
+	if (regmap_bulk_read(rt1320->regmap, sig_addr, buf, sizeof(buf)))
 		return false;
-	}
 
-	return true;
+	return get_unaligned_le32(buf) == crc;
+}
+
+static int rt1320_mcu_patch_set_sig(struct rt1320_priv *rt1320,
+	unsigned int sig_addr, u32 crc)
+{
+	u8 buf[RT1320_MCU_PATCH_SIG_LEN];
+
+	put_unaligned_le32(crc, buf);
+
+	return rt1320_bulk_write(rt1320, sig_addr, buf, sizeof(buf));
 }
 
 /*
  * The 'patch code' is written to the patch code area.
+ *
+ * The whole image is validated and assembled into a copy of the patch
+ * window first, so a bad record leaves the MCU untouched. The populated
+ * ranges are then written with bulk transfers.
  */
 static void rt1320_load_mcu_patch(struct rt1320_priv *rt1320)
 {
@@ -251,10 +297,13 @@ static void rt1320_load_mcu_patch(struct rt1320_priv *rt1320)
 	const struct firmware *patch;
 	const char *filename;
 #define BIN_IS_BIG_ENDIAN
-#if 1
-	unsigned int addr, val;
+	unsigned int addr, val, start, end, sig_addr = 0, xfers = 0;
 	const unsigned char *ptr;
-#endif
+	size_t size;
+	u32 crc = 0;
+	unsigned long *used = NULL;
+	u8 *image = NULL;
+	ktime_t t0 = ktime_get();
 	int ret, i;
 
 	if (rt1320->version_id <= RT1320_VB)
@@ -267,101 +316,370 @@ static void rt1320_load_mcu_patch(struct rt1320_priv *rt1320)
 	ret = request_firmware(&patch, filename, dev);
 	if (ret) {
 		dev_err(dev, "%s: Failed to load %s firmware", __func__, filename);
-#if 0
-		regmap_write(rt1320->regmap, 0xc598, 0x00);
-		regmap_write(rt1320->regmap, 0x10007000, 0x67);
-		regmap_write(rt1320->regmap, 0x10007001, 0x80);
-		regmap_write(rt1320->regmap, 0x10007002, 0x00);
-		regmap_write(rt1320->regmap, 0x10007003, 0x00);
-#endif
-	} else {
-#if 0
-		for (i = 0; i < RT1320_MCU_PATCH_LEN; i++)
-			regmap_write(rt1320->regmap, mcu_patch_code[i].reg, mcu_patch_code[i].def);
-#else
-		ptr = (const unsigned char *)patch->data;
-		if ((patch->size % 8) == 0) {
-			for (i = 0; i < patch->size; i += 8) {
+		return;
+	}
+
+	if (!patch->size || (patch->size % 8)) {
+		dev_err(dev, "%s: the size %zu is wrong", __func__, patch->size);
+		goto _exit_;
+	}
+
+	image = kzalloc(RT1320_MCU_PATCH_SIZE, GFP_KERNEL);
+	used = bitmap_zalloc(RT1320_MCU_PATCH_SIZE, GFP_KERNEL);
+	if (!image || !used)
+		goto _exit_;
+
+	ptr = (const unsigned char *)patch->data;
+	size = patch->size;
+
+	/* optional signature record, see rt1320_mcu_patch_loaded() */
 #ifdef BIN_IS_BIG_ENDIAN
-				addr = (ptr[i] & 0xff) << 24 | (ptr[i + 1] & 0xff) << 16 |
-					(ptr[i + 2] & 0xff) << 8 | (ptr[i + 3] & 0xff);
-				val = (ptr[i + 4] & 0xff) << 24 | (ptr[i + 5] & 0xff) << 16 |
-					(ptr[i + 6] & 0xff) << 8 | (ptr[i + 7] & 0xff);
+	addr = get_unaligned_be32(&ptr[size - 8]);
+	val = get_unaligned_be32(&ptr[size - 4]);
 #else
-				addr = (ptr[i] & 0xff) | (ptr[i + 1] & 0xff) << 8 |
-					(ptr[i + 2] & 0xff) << 16 | (ptr[i + 3] & 0xff) << 24;
-				val = (ptr[i + 4] & 0xff) | (ptr[i + 5] & 0xff) << 8 |
-					(ptr[i + 6] & 0xff) << 16 | (ptr[i + 7] & 0xff) << 24;
+	addr = get_unaligned_le32(&ptr[size - 8]);
+	val = get_unaligned_le32(&ptr[size - 4]);
 #endif
-				if (addr > 0x10007fff || addr < 0x10007000) {
-					dev_err(dev, "%s: the address 0x%x is wrong", __func__, addr);
-					goto _exit_;
-				}
-				if (val > 0xff) {
-					dev_err(dev, "%s: the value 0x%x is wrong", __func__, val);
-					goto _exit_;
-				}
-				regmap_write(rt1320->regmap, addr, val);
-			}
+	if (addr == RT1320_MCU_PATCH_SIG_ID) {
+		if (val < RT1320_MCU_PATCH_BASE ||
+		    val > RT1320_MCU_PATCH_BASE + RT1320_MCU_PATCH_SIZE -
+			  RT1320_MCU_PATCH_SIG_LEN) {
+			dev_err(dev, "%s: the signature address 0x%x is wrong", __func__, val);
+			goto _exit_;
 		}
-_exit_:
+		sig_addr = val;
+		size -= 8;
+	}
+
+	for (i = 0; i < size; i += 8) {
+#ifdef BIN_IS_BIG_ENDIAN
+		addr = get_unaligned_be32(&ptr[i]);
+		val = get_unaligned_be32(&ptr[i + 4]);
+#else
+		addr = get_unaligned_le32(&ptr[i]);
+		val = get_unaligned_le32(&ptr[i + 4]);
 #endif
-		release_firmware(patch);
+		if (addr >= RT1320_MCU_PATCH_BASE + RT1320_MCU_PATCH_SIZE ||
+		    addr < RT1320_MCU_PATCH_BASE) {
+			dev_err(dev, "%s: the address 0x%x is wrong", __func__, addr);
+			goto _exit_;
+		}
+		if (val > 0xff) {
+			dev_err(dev, "%s: the value 0x%x is wrong", __func__, val);
+			goto _exit_;
+		}
+		image[addr - RT1320_MCU_PATCH_BASE] = val;
+		set_bit(addr - RT1320_MCU_PATCH_BASE, used);
+	}
+
+	if (sig_addr) {
+		start = sig_addr - RT1320_MCU_PATCH_BASE;
+		end = start + RT1320_MCU_PATCH_SIG_LEN;
+		if (find_next_bit(used, end, start) < end) {
+			dev_err(dev, "%s: the signature at 0x%x overlaps the patch",
+				__func__, sig_addr);
+			goto _exit_;
+		}
 	}
+
+	crc = crc32_le(~0, patch->data, size) ^ ~0;
+	if (!crc)
+		crc = 1; /* 0 is the cleared slot */
+
+	if (sig_addr && !force_mcu_patch &&
+	    rt1320_mcu_patch_loaded(rt1320, sig_addr, crc)) {
+		dev_dbg(dev, "%s: %s (crc 0x%08x) already loaded\n", __func__,
+			filename, crc);
+		trace_rt1320_mcu_patch(dev, filename, crc, size / 8, 0,
+			ktime_us_delta(ktime_get(), t0), true, 0);
+		goto _exit_;
+	}
+
+	/* invalidate the old signature until the new patch is complete */
+	if (sig_addr) {
+		ret = rt1320_mcu_patch_set_sig(rt1320, sig_addr, 0);
+		if (ret) {
+			dev_err(dev, "%s: clearing the signature failed: %d", __func__, ret);
+			goto _exit_;
+		}
+	}
+
+	for (start = find_first_bit(used, RT1320_MCU_PATCH_SIZE);
+	     start < RT1320_MCU_PATCH_SIZE;
+	     start = find_next_bit(used, RT1320_MCU_PATCH_SIZE, end)) {
+		end = find_next_zero_bit(used, RT1320_MCU_PATCH_SIZE, start);
+		addr = RT1320_MCU_PATCH_BASE + start;
+
+		ret = rt1320_bulk_write(rt1320, addr, image + start, end - start);
+		if (ret) {
+			dev_err(dev, "%s: write 0x%x (%u bytes) failed: %d", __func__,
+				addr, end - start, ret);
+			break;
+		}
+		xfers++;
+	}
+
+	if (!ret && sig_addr)
+		ret = rt1320_mcu_patch_set_sig(rt1320, sig_addr, crc);
+
+	dev_dbg(dev, "%s: %zu bytes in %u transfers, ret=%d\n", __func__,
+		size / 8, xfers, ret);
+	trace_rt1320_mcu_patch(dev, filename, crc, size / 8, xfers,
+		ktime_us_delta(ktime_get(), t0), false, ret);
+
+_exit_:
+	bitmap_free(used);
+	kfree(image);
+	release_firmware(patch);
 }
 
-static void log_fp_write(char *str, int slen)
+/*
+ * Readiness waits. The register is polled with a few short spins first,
+ * then with an exponentially growing (hrtimer) sleep, as set by the
+ * profile. The codec interrupt is not used, no documented interrupt
+ * source signals MCU or mailbox readiness.
+ */
+struct rt1320_wait_profile {
+	unsigned int spin_us;
+	unsigned int spins;
+	unsigned int sleep_min_us;
+	unsigned int sleep_max_us;
+};
+
+/* MCU and DSP bring-up, which take milliseconds */
+static const struct rt1320_wait_profile rt1320_wait_default = {
+	.spin_us = 10,
+	.spins = 8,
+	.sleep_min_us = 100,
+	.sleep_max_us = 2000,
+};
+
+/* Mailbox commands, which the DSP usually answers within microseconds */
+static const struct rt1320_wait_profile rt1320_wait_mbox = {
+	.spin_us = 5,
+	.spins = 16,
+	.sleep_min_us = 20,
+	.sleep_max_us = 500,
+};
+
+static const unsigned int rt1320_wait_hist_us[RT1320_WAIT_HIST_LEN] = {
+	10, 50, 100, 500, 1000, 5000, 10000, UINT_MAX,
+};
+
+static void rt1320_wait_account(struct rt1320_wait_hist *hist, s64 us, int ret)
+{
+	int i;
+
+	if (ret == -ETIMEDOUT)
+		atomic_inc(&hist->timeouts);
+
+	for (i = 0; i < RT1320_WAIT_HIST_LEN - 1; i++)
+		if (us < rt1320_wait_hist_us[i])
+			break;
+	atomic_inc(&hist->count[i]);
+}
+
+/*
+ * Wait until @check returns > 0, for at most @timeout_us.
+ * @check returns 1 when ready, 0 when not ready yet, or a negative error.
+ * Returns 0 when ready, -ETIMEDOUT or the error from @check.
+ */
+static int rt1320_wait_poll(struct rt1320_priv *rt1320,
+	const struct rt1320_wait_profile *prof,
+	int (*check)(struct rt1320_priv *rt1320, void *arg), void *arg,
+	unsigned int timeout_us)
 {
+	ktime_t start = ktime_get();
+	ktime_t timeout = ktime_add_us(start, timeout_us);
+	unsigned int spins = 0, sleep_us = prof->sleep_min_us;
 	int ret;
-	char buf[100] = {0};
 
-	memcpy(buf, str, slen);
-	buf[slen] = '\n';
+	for (;;) {
+		ret = check(rt1320, arg);
+		if (ret) {
+			ret = min(ret, 0);
+			break;
+		}
+
+		if (ktime_after(ktime_get(), timeout)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
 
-	if (log_fp && !IS_ERR(log_fp)) {
-		ret = kernel_write(log_fp, buf, slen + 1, &log_pos);
-		if (ret < 0)
-			pr_err("write (%s) to log file failed: %d\n", str, ret);
+		if (spins < prof->spins) {
+			udelay(prof->spin_us);
+			spins++;
+		} else {
+			usleep_range(sleep_us, sleep_us + sleep_us / 2);
+			sleep_us = min(sleep_us * 2, prof->sleep_max_us);
+		}
 	}
+
+	rt1320_wait_account(&rt1320->wait_hist,
+		ktime_us_delta(ktime_get(), start), ret);
+
+	return ret;
+}
+
+struct rt1320_wait_reg_arg {
+	unsigned int reg;
+	unsigned int mask;
+	unsigned int val;
+};
+
+static int rt1320_wait_reg_check(struct rt1320_priv *rt1320, void *arg)
+{
+	struct rt1320_wait_reg_arg *w = arg;
+	unsigned int tmp;
+	int ret;
+
+	ret = regmap_read(rt1320->regmap, w->reg, &tmp);
+	if (ret)
+		return ret;
+
+	return (tmp & w->mask) == w->val;
+}
+
+/*
+ * Wait until (@reg & @mask) == @val, for at most @timeout_us.
+ * Returns 0 when the condition is met, -ETIMEDOUT or the read error.
+ */
+static int rt1320_wait_reg(struct rt1320_priv *rt1320,
+	const struct rt1320_wait_profile *prof, unsigned int reg,
+	unsigned int mask, unsigned int val, unsigned int timeout_us)
+{
+	struct rt1320_wait_reg_arg w = {
+		.reg = reg,
+		.mask = mask,
+		.val = val,
+	};
+
+	return rt1320_wait_poll(rt1320, prof, rt1320_wait_reg_check, &w, timeout_us);
 }
 
+#define RT1320_MCU_READY_TIMEOUT_US	300000
+
 static void rt1320_vc_preset(struct rt1320_priv *rt1320)
 {
-	unsigned int i, reg, val, delay, retry, tmp;
+	const u8 *p = rt1320_bind_write_packed;
+	const u8 *end = p + RT1320_BIND_WRITE_PACKED_LEN;
+	unsigned int reg, len, delay, xfers = 0;
 	struct device *dev = regmap_get_device(rt1320->regmap);
+	ktime_t start = ktime_get();
+	int ret;
+
 	dev_dbg(dev, "-> %s\n", __func__);
 
-	for (i = 0; i < RT1320_BIND_WRITE_LEN; i++) {
-		reg = rt1320_bind_write[i].reg;
-		val = rt1320_bind_write[i].def;
-		delay = rt1320_bind_write[i].delay_us;
-
-		if ((reg == 0x1000db00) && (val == 0x05)) {
-			retry = 200;
-#if 1
-			while (retry) {
-				regmap_read(rt1320->regmap, RT1320_KR0_INT_READY, &tmp);
-				dev_dbg(dev, "%s, RT1320_KR0_INT_READY=0x%x, retry=%d\n", __func__, tmp, retry);
-				if (tmp == 0x1f)
-					break;
-				usleep_range(1000, 1500);
-				retry--;
-			}
-			if (!retry)
-				dev_warn(dev, "%s MCU is NOT ready!", __func__);
-#endif
-		}
+	while (p < end) {
+		switch (*p++) {
+		case RT1320_PACK_WRITE:
+			reg = get_unaligned_le32(p);
+			len = get_unaligned_le16(p + 4);
+			p += 6;
+			ret = rt1320_bulk_write(rt1320, reg, p, len);
+			if (ret)
+				dev_err(dev, "%s: write 0x%08x (%u regs) failed: %d\n",
+					__func__, reg, len, ret);
+			p += len;
+			xfers++;
+			break;
 
-		regmap_write(rt1320->regmap, reg, val);
-		if (delay)
+		case RT1320_PACK_DELAY:
+			delay = get_unaligned_le32(p);
+			p += 4;
 			usleep_range(delay, delay + 1000);
+			break;
+
+		case RT1320_PACK_WAIT_MCU:
+			if (rt1320_wait_reg(rt1320, &rt1320_wait_default,
+					RT1320_KR0_INT_READY, 0xff, 0x1f,
+					RT1320_MCU_READY_TIMEOUT_US))
+				dev_warn(dev, "%s MCU is NOT ready!", __func__);
+			break;
 
-		if (reg == 0x0000d486 && val == 0xc3) {
+		case RT1320_PACK_LOAD_PATCH:
 			dev_dbg(dev, "Load MCU patch start\n");
 			rt1320_load_mcu_patch(rt1320);
 			dev_dbg(dev, "Load MCU patch end\n");
+			break;
+
+		default:
+			dev_err(dev, "%s: bad record at offset %td\n", __func__,
+				p - 1 - rt1320_bind_write_packed);
+			return;
 		}
 	}
+
+	dev_dbg(dev, "%s: %u transfers, %lld us\n", __func__, xfers,
+		ktime_us_delta(ktime_get(), start));
+}
+
+/*
+ * The preset runs asynchronously from the component probe so the card can
+ * register without waiting for the amp. Anything that needs the amp
+ * configured waits here first, control puts included: the preset resets
+ * the amp and would overwrite their values.
+ */
+#define RT1320_PRESET_TIMEOUT_MS	5000
+
+static void rt1320_preset_work(struct work_struct *work)
+{
+	struct rt1320_priv *rt1320 = container_of(work, struct rt1320_priv,
+		preset_work);
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	ktime_t start = ktime_get();
+
+	rt1320_vc_preset(rt1320);
+
+	rt1320->preset_time_us = ktime_us_delta(ktime_get(), start);
+	dev_info(dev, "%s: bring-up done in %lld us\n", __func__,
+		rt1320->preset_time_us);
+
+	complete_all(&rt1320->preset_done);
+}
+
+static int rt1320_wait_preset(struct rt1320_priv *rt1320)
+{
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	unsigned long left;
+
+	left = wait_for_completion_timeout(&rt1320->preset_done,
+		msecs_to_jiffies(RT1320_PRESET_TIMEOUT_MS));
+	if (!left) {
+		dev_err(dev, "%s: bring-up did not finish in %d ms\n", __func__,
+			RT1320_PRESET_TIMEOUT_MS);
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+static int rt1320_put_volsw(struct snd_kcontrol *kcontrol,
+	struct snd_ctl_elem_value *ucontrol)
+{
+	struct snd_soc_component *component = snd_kcontrol_chip(kcontrol);
+	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
+	int ret;
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
+
+	return snd_soc_put_volsw(kcontrol, ucontrol);
+}
+
+static int rt1320_put_enum_double(struct snd_kcontrol *kcontrol,
+	struct snd_ctl_elem_value *ucontrol)
+{
+	struct snd_soc_component *component = snd_kcontrol_chip(kcontrol);
+	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
+	int ret;
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
+
+	return snd_soc_put_enum_double(kcontrol, ucontrol);
 }
 
 static const char * const rt1320_dsp_ib0_select[] = {
@@ -411,162 +729,293 @@ static void rt1320_fw_param_write(struct rt1320_priv *rt1320,
 	for (i = 0; i < buf_size; i++)
 		regmap_write(rt1320->regmap, start_addr + i, buf[i]);
 #else // SPI
-	ret = rt1320_spi_burst_write(start_addr, buf, buf_size);
+	ret = rt1320_spi_burst_write(rt1320->spi, start_addr, buf, buf_size);
 	if (ret)
 		dev_err(rt1320->component->dev,
 			"%s: SPI write FW failed, ret=%d\n", __func__, ret);
 #endif
-	printk("%s, done\n", __func__);
 }
 
-static void rt1320_fw_param_read(struct rt1320_priv *rt1320,
-	unsigned int start_addr, char *buf, unsigned int buf_size)
-{
-	int ret;
-#ifdef RT1320_I2C_FW_RD
-	int i;
-	for (i = 0; i < buf_size; i++) {
-		ret = regmap_read(rt1320->regmap, start_addr + i, (unsigned int *)&buf[i]);
-		if (ret) {
-			dev_err(rt1320->component->dev,
-				"%s: I2C read FW failed, ret=%d\n", __func__, ret);
-			break;
-		}
-	}
-#else // SPI
-	ret = rt1320_spi_burst_read(start_addr, (u8 *)buf, buf_size);
-	if (ret) {
-		dev_err(rt1320->component->dev,
-			"%s: SPI read FW failed, ret=%d\n", __func__, ret);
-	}
-#endif
-	printk("%s, done\n", __func__);
-}
+/*
+ * Read a segment back in RT1320_FW_CHECK_CHUNK pieces, so memory use does
+ * not depend on the segment size. Comparison stops at the first mismatch
+ * unless the segment is also being dumped.
+ */
+#define RT1320_FW_CHECK_CHUNK	4096
 
 static int rt1320_dsp_fw_check(struct rt1320_priv *rt1320, unsigned int start_addr, const u8 *txbuf,
 	unsigned int fw_size, bool dump_fw, bool compare)
 {
 	struct device *dev = regmap_get_device(rt1320->regmap);
-	struct file *fp;
+	struct file *fp = NULL;
 	loff_t pos = 0;
-	int i, ret = 0, len;
-	unsigned int val, done;
-	const unsigned int count = 64;
+	int i, ret = 0, err = 0;
+	unsigned int done, len;
 	u8 *rxbuf = NULL;
 	char dumpfile[100] = {0};
-	if (dump_fw)
-		sprintf(dumpfile, "/lib/firmware/rt1320/0x%08x.dump", start_addr);
+	ktime_t t0 = ktime_get();
+	s64 us;
 
-	rxbuf = kmalloc(fw_size, GFP_KERNEL);
+	rxbuf = kmalloc(RT1320_FW_CHECK_CHUNK, GFP_KERNEL);
 	if (!rxbuf) {
 		pr_err("Can't create rxbuf!\n");
 		return -ENOMEM;
 	}
 
-#ifdef RT1320_I2C_FW_RD
-	// regcache_cache_bypass(rt1320->regmap, true);
-	for(i = 0; i < fw_size; i++) {
-		regmap_read(rt1320->regmap, start_addr + i, &val);
-		rxbuf[i] = val;
-	}
-	// regcache_cache_bypass(rt1320->regmap, false);
-#else
-	rt1320_spi_burst_read(start_addr, rxbuf, fw_size);
-#endif
 	if (dump_fw) {
+		sprintf(dumpfile, "/lib/firmware/rt1320/0x%08x.dump", start_addr);
 		fp = filp_open(dumpfile, O_WRONLY | O_CREAT, 0644);
-		if (!IS_ERR(fp)) {
-			done = 0;
-			while (done < fw_size) {
-				len = min(count, fw_size - done);
-				ret = kernel_write(fp, &rxbuf[done], len, &pos);
-				if (ret < 0) {
-					dev_err(dev, "write %s error: %d\n", dumpfile, ret);
-					break;
-				}
-				done += len;
-			}
-			if (ret >= 0)
-				ret = 0;
-		} else {
+		if (IS_ERR(fp)) {
 			dev_err(dev, "open %s error: %d\n", dumpfile, (int)PTR_ERR(fp));
-			ret = (int)PTR_ERR(fp);
+			err = (int)PTR_ERR(fp);
+			fp = NULL;
+			dump_fw = false;
 		}
 	}
 
-	if (compare && memcmp(txbuf, rxbuf, fw_size)){
-		pr_err("%s: fw_addr:%x update fail!\n", __func__, start_addr);
-		ret = -EINVAL;
+	for (done = 0; done < fw_size; done += len) {
+		len = min_t(unsigned int, RT1320_FW_CHECK_CHUNK, fw_size - done);
+
+		ret = regmap_raw_read(rt1320->regmap, start_addr + done, rxbuf, len);
+		if (ret) {
+			dev_err(dev, "%s: read 0x%08x failed: %d\n", __func__,
+				start_addr + done, ret);
+			err = ret;
+			break;
+		}
+
+		if (dump_fw) {
+			ret = kernel_write(fp, rxbuf, len, &pos);
+			if (ret < 0) {
+				dev_err(dev, "write %s error: %d\n", dumpfile, ret);
+				err = ret;
+				dump_fw = false;
+			}
+		}
+
+		if (compare && memcmp(txbuf + done, rxbuf, len)) {
+			for (i = 0; i < len && txbuf[done + i] == rxbuf[i]; i++)
+				;
+			dev_err(dev, "%s: fw_addr:%x mismatch at offset 0x%x (0x%08x): %02x != %02x\n",
+				__func__, start_addr, done + i, start_addr + done + i,
+				rxbuf[i], txbuf[done + i]);
+			err = -EINVAL;
+			compare = false;
+		}
+
+		if (!compare && !dump_fw)
+			break;
 	}
 
+	us = ktime_us_delta(ktime_get(), t0);
+	if (!err)
+		dev_dbg(dev, "%s: %u bytes at 0x%08x in %lld us (%lld KB/s)\n", __func__,
+			fw_size, start_addr, us, us ? div_s64((s64)fw_size * 1000, us) : 0);
+
 	kfree(rxbuf);
-	if (dump_fw)
+	if (fp)
 		filp_close(fp, NULL);
 
-	return ret;
+	return err;
 }
 
-static int rt1320_afx_load(struct rt1320_priv *rt1320, unsigned char action)
+/*
+ * Sampled verification: RT1320_FW_VERIFY_SAMPLES windows spread evenly
+ * over the segment, including its first and last bytes, are read back and
+ * their CRC compared with the CRC of the same windows in the blob. This
+ * catches misrouted or truncated loads at a small fraction of the bus time
+ * of a full read-back, which stays available through fw_verify_full.
+ */
+#define RT1320_FW_VERIFY_SAMPLES	16
+#define RT1320_FW_VERIFY_WINDOW		256
+
+static bool fw_verify_full;
+module_param(fw_verify_full, bool, 0644);
+MODULE_PARM_DESC(fw_verify_full, "Verify DSP firmware updates by dumping and comparing every byte");
+
+static int rt1320_dsp_fw_verify(struct rt1320_priv *rt1320, unsigned int start_addr,
+	const u8 *txbuf, unsigned int fw_size)
 {
 	struct device *dev = regmap_get_device(rt1320->regmap);
-	char afx_names[3][50] = {
-			"rt1320/AFX0_Ram.bin",
-			"rt1320/AFX1_Ram.bin",
-			"rt1320/AFX1_Ram_RTLSM.bin" }; // modify the correct paths
-	unsigned int afx_addrs[3] = {
-			RT1320_AFX0_LOAD_ADDR,
-			RT1320_AFX1_LOAD_ADDR,
-			RT1320_AFXRTLSM_LOAD_ADDR };
-	char hdr_start[] = "AFX";
-	const struct firmware *fw = NULL;
-	struct firmware fmw;
-	int i, ret, hdr_size = 0;
-	bool dump_fw = (action == 2 || action == 3) ? true : false;
-	bool compare = (action == 3) ? true : false;
+	unsigned int k, offset, span;
+	u8 *rxbuf;
+	u32 crc;
+	int ret = 0;
+
+	if (fw_size <= RT1320_FW_VERIFY_SAMPLES * RT1320_FW_VERIFY_WINDOW)
+		return rt1320_dsp_fw_check(rt1320, start_addr, txbuf, fw_size, false, true);
 
-	for (i = 0; i < 3; i++) {
+	rxbuf = kmalloc(RT1320_FW_VERIFY_WINDOW, GFP_KERNEL);
+	if (!rxbuf)
+		return -ENOMEM;
+
+	span = fw_size - RT1320_FW_VERIFY_WINDOW;
+	for (k = 0; k < RT1320_FW_VERIFY_SAMPLES; k++) {
+		offset = div_u64((u64)span * k, RT1320_FW_VERIFY_SAMPLES - 1);
+		if (k < RT1320_FW_VERIFY_SAMPLES - 1)
+			offset = round_down(offset, 8);
 
-		ret = request_firmware(&fw, afx_names[i], dev);
+		ret = regmap_raw_read(rt1320->regmap, start_addr + offset, rxbuf,
+			RT1320_FW_VERIFY_WINDOW);
 		if (ret) {
-			dev_err(dev, "Request firmware %s failed\n", afx_names[i]);
-			ret = -ENOENT;
-			goto out;
+			dev_err(dev, "%s: read 0x%08x failed: %d\n", __func__,
+				start_addr + offset, ret);
+			break;
 		}
 
-		if (!fw->size) {
-			dev_err(dev, "\"%s\" file read error\n", afx_names[i]);
+		crc = crc32_le(~0, rxbuf, RT1320_FW_VERIFY_WINDOW);
+		if (crc != crc32_le(~0, txbuf + offset, RT1320_FW_VERIFY_WINDOW)) {
+			dev_err(dev, "%s: fw_addr:%x CRC mismatch in window 0x%x..0x%x\n",
+				__func__, start_addr, offset,
+				offset + RT1320_FW_VERIFY_WINDOW - 1);
 			ret = -EINVAL;
-			goto out;
+			break;
 		}
+	}
 
-		if (memcmp(fw->data, hdr_start, sizeof(hdr_start)) == 0)
-			hdr_size = 64; // The bin file has a header of 64 bytes
-		else
-			hdr_size = 0;
-		dev_dbg(dev, "AFX%d FW_0x%08x, FW size is 0x%x, Extra Heder size is %d\n", i, afx_addrs[i],
-			fw->size, hdr_size);
+	kfree(rxbuf);
 
-		fmw.size = fw->size - hdr_size;
-		fmw.data = fw->data + hdr_size;
+	return ret;
+}
+
+/*
+ * DSP firmware segments. The loader fetches segment N + 1 from the file
+ * system while segment N is being written to the DSP.
+ */
+struct rt1320_fw_seg {
+	const char *name;
+	unsigned int addr;
+	bool afx; /* may start with a 64 byte "AFX" header */
+};
+
+/* the first segment's area, overwritten by the load, is scratch until then */
+#define RT1320_DSP_SCRATCH_ADDR		0x3fc000c0
+#define RT1320_DSP_SCRATCH_SIZE		(0x3fc01110 - RT1320_DSP_SCRATCH_ADDR + 1)
+
+static const struct rt1320_fw_seg rt1320_dsp_segs[] = {
+	{ "rt1320/0x3fc000c0.dat", 0x3fc000c0 },
+	{ "rt1320/0x3fc29d80.dat", 0x3fc29d80 },
+	{ "rt1320/0x3fe00000.dat", 0x3fe00000 },
+	{ "rt1320/0x3fe02000.dat", 0x3fe02000 },
+};
+
+static const struct rt1320_fw_seg rt1320_afx_segs[] = {
+	{ "rt1320/AFX0_Ram.bin", RT1320_AFX0_LOAD_ADDR, true },
+	{ "rt1320/AFX1_Ram.bin", RT1320_AFX1_LOAD_ADDR, true },
+	{ "rt1320/AFX1_Ram_RTLSM.bin", RT1320_AFXRTLSM_LOAD_ADDR, true },
+};
+
+struct rt1320_fw_fetch {
+	const struct firmware *fw;
+	struct completion done;
+};
+
+static void rt1320_fw_fetch_cb(const struct firmware *fw, void *context)
+{
+	struct rt1320_fw_fetch *fetch = context;
+
+	fetch->fw = fw;
+	complete(&fetch->done);
+}
+
+static void rt1320_fw_fetch_start(struct rt1320_priv *rt1320,
+	const struct rt1320_fw_seg *seg, struct rt1320_fw_fetch *fetch)
+{
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	int ret;
+
+	fetch->fw = NULL;
+	init_completion(&fetch->done);
+
+	ret = request_firmware_nowait(THIS_MODULE, FW_ACTION_UEVENT, seg->name,
+		dev, GFP_KERNEL, fetch, rt1320_fw_fetch_cb);
+	if (ret)
+		complete(&fetch->done);
+}
+
+static int rt1320_load_fw_segs(struct rt1320_priv *rt1320,
+	const struct rt1320_fw_seg *segs, int num, unsigned char action)
+{
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	const char hdr_start[] = "AFX";
+	struct rt1320_fw_fetch *fetch;
+	const struct firmware *fw;
+	const u8 *data;
+	size_t size;
+	ktime_t t0;
+	int i, ret = 0;
+	bool dump_fw = (action == 2 || (action == 3 && fw_verify_full)) ? true : false;
+	bool compare = (action == 3) ? true : false;
+
+	fetch = kcalloc(num, sizeof(*fetch), GFP_KERNEL);
+	if (!fetch)
+		return -ENOMEM;
+
+	rt1320_fw_fetch_start(rt1320, &segs[0], &fetch[0]);
 
-		rt1320_fw_param_write(rt1320, afx_addrs[i], fmw.data, fmw.size);
+	for (i = 0; i < num; i++) {
+		if (i + 1 < num)
+			rt1320_fw_fetch_start(rt1320, &segs[i + 1], &fetch[i + 1]);
 
-		if (dump_fw || compare) {
-			if (rt1320_dsp_fw_check(rt1320, afx_addrs[i], fmw.data, fmw.size, dump_fw, compare))
+		wait_for_completion(&fetch[i].done);
+		fw = fetch[i].fw;
+		if (!fw) {
+			dev_err(dev, "%s: Failed to get firmware %s\n", __func__, segs[i].name);
+			ret = ret ? ret : -ENOENT;
+			continue;
+		}
+
+		data = fw->data;
+		size = fw->size;
+		if (segs[i].afx && size >= 64 && !memcmp(data, hdr_start, sizeof(hdr_start))) {
+			data += 64; // The bin file has a header of 64 bytes
+			size -= 64;
+		}
+
+		if (!size) {
+			dev_err(dev, "\"%s\" file read error\n", segs[i].name);
+			ret = ret ? ret : -EINVAL;
+			release_firmware(fw);
+			continue;
+		}
+
+		dev_info(dev, "%s: FW_0x%08x size=0x%zx\n", __func__, segs[i].addr, size);
+		trace_rt1320_fw_seg_start(dev, segs[i].name, segs[i].addr, size);
+		t0 = ktime_get();
+		rt1320_fw_param_write(rt1320, segs[i].addr, data, size);
+		trace_rt1320_fw_seg_end(dev, segs[i].name, segs[i].addr, size,
+			ktime_us_delta(ktime_get(), t0));
+
+		if (compare && !fw_verify_full) {
+			if (rt1320_dsp_fw_verify(rt1320, segs[i].addr, data, size))
+				pr_err("%s verify failed!\n", segs[i].name);
+			else
+				dev_dbg(dev, "%s verified\n", segs[i].name);
+		} else if (dump_fw || compare) {
+			if (rt1320_dsp_fw_check(rt1320, segs[i].addr, data, size, dump_fw, compare))
 				pr_err("%s %s failed!\n",
-					afx_names[i], action == 2 ? "dump" : "update");
+					segs[i].name, action == 2 ? "dump" : "update");
 			else
 				pr_err("%s %s succeeded!\n",
-					afx_names[i], action == 2 ? "dump" : "update");
+					segs[i].name, action == 2 ? "dump" : "update");
 		}
-	}
-out:
-	if (fw)
+
 		release_firmware(fw);
+	}
+
+	kfree(fetch);
 
 	return ret;
 }
 
+static int rt1320_wait_dsp_ready(struct rt1320_priv *rt1320);
+
+static int rt1320_afx_load(struct rt1320_priv *rt1320, unsigned char action)
+{
+	return rt1320_load_fw_segs(rt1320, rt1320_afx_segs,
+		ARRAY_SIZE(rt1320_afx_segs), action);
+}
+
 static int rt1320_dsp_path_get(struct snd_kcontrol *kcontrol,
 	struct snd_ctl_elem_value *ucontrol)
 {
@@ -591,7 +1040,11 @@ static int rt1320_dsp_path_put(struct snd_kcontrol *kcontrol,
 	struct snd_soc_component *component = snd_kcontrol_chip(kcontrol);
 	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
 	unsigned int bypass;
-	int changed = 0;
+	int changed = 0, ret;
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
 
 	dev_dbg(component->dev, "%s, bypass=%ld\n", __func__, ucontrol->value.integer.value[0]);
 	bypass = ucontrol->value.integer.value[0];
@@ -618,24 +1071,24 @@ static int rt1320_dsp_path_put(struct snd_kcontrol *kcontrol,
 	return changed;
 }
 
-static void rt1320_pr_read(struct rt1320_priv *rt1320, unsigned int reg, unsigned int *val);
+static int rt1320_pr_read_multi(struct rt1320_priv *rt1320, struct reg_default *prs, int num);
 
 static void rt1320_get_rsgain(struct rt1320_priv *rt1320, unsigned short *rs)
 {
 	struct snd_soc_component *component = rt1320->component;
-	struct reg_default pr1058 = {0x1058, 0};
-	struct reg_default pr1059 = {0x1059, 0};
-	struct reg_default pr105a = {0x105a, 0};
+	struct reg_default pr[] = {
+		{ 0x1058, 0 },
+		{ 0x1059, 0 },
+		{ 0x105a, 0 },
+	};
 
-	rt1320_pr_read(rt1320, pr1058.reg, &pr1058.def);
-	rt1320_pr_read(rt1320, pr1059.reg, &pr1059.def);
-	rt1320_pr_read(rt1320, pr105a.reg, &pr105a.def);
+	rt1320_pr_read_multi(rt1320, pr, ARRAY_SIZE(pr));
 
-	dev_dbg(component->dev, "PR[%X %X %X] = {%02X, %02X, %02X}\n", pr1058.reg, pr1059.reg, pr105a.reg,
-		pr1058.def & 0xff, pr1059.def & 0xff, pr105a.def & 0xff);
+	dev_dbg(component->dev, "PR[%X %X %X] = {%02X, %02X, %02X}\n", pr[0].reg, pr[1].reg, pr[2].reg,
+		pr[0].def & 0xff, pr[1].def & 0xff, pr[2].def & 0xff);
 
-	rs[0] = (pr1059.def & 0x7f) << 2 | (pr105a.def & 0xc0) >> 6;
-	rs[1] = (pr1058.def & 0xff) << 1 | (pr1059.def & 0x80) >> 7;
+	rs[0] = (pr[1].def & 0x7f) << 2 | (pr[2].def & 0xc0) >> 6;
+	rs[1] = (pr[0].def & 0xff) << 1 | (pr[1].def & 0x80) >> 7;
 }
 
 static u32 rt1320_rsgain_to_rsratio(struct rt1320_priv *rt1320, unsigned int rsgain)
@@ -658,88 +1111,122 @@ static u32 rt1320_rsgain_to_rsratio(struct rt1320_priv *rt1320, unsigned int rsg
 }
 
 static u32 rs_ratio_mx[2] = {0};
+static void rt1320_spi_release(void *data)
+{
+	rt1320_spi_put(data);
+}
+
+/*
+ * Bind the SPI companion of this codec. Without an explicit reference the
+ * companion may probe after the codec, so this is retried at first use.
+ */
+static int rt1320_spi_attach(struct rt1320_priv *rt1320, struct device *dev)
+{
+	struct rt1320_spi *rspi;
+
+	if (rt1320->spi)
+		return 0;
+
+	rspi = rt1320_spi_get(dev);
+	if (IS_ERR(rspi))
+		return PTR_ERR(rspi);
+	if (!rspi)
+		return -ENODEV;
+
+	rt1320->spi = rspi;
+	dev_dbg(dev, "SPI companion bound\n");
+
+	return devm_add_action_or_reset(dev, rt1320_spi_release, rspi);
+}
+
+/*
+ * Host copies of the DSP parameter blocks that only change when the driver
+ * writes them (rt1320_param_shadowed). GETs of those are answered from the
+ * copy and SETs update it. A firmware load drops every copy, and the
+ * generation count keeps a GET that raced with the load from refilling
+ * them with old values.
+ */
+static const unsigned long rt1320_param_shadowed = BIT(0x06) | BIT(0x07);
+
+static bool rt1320_shadow_get(struct rt1320_priv *rt1320, unsigned int id,
+	void *buf, unsigned int size)
+{
+	bool hit = false;
+
+	if (id >= RT1320_PARAM_SHADOW_IDS || !(rt1320_param_shadowed & BIT(id)))
+		return false;
+
+	spin_lock(&rt1320->cmd_lock);
+	if (size <= rt1320->shadow[id].size) {
+		memcpy(buf, rt1320->shadow[id].data, size);
+		hit = true;
+	}
+	spin_unlock(&rt1320->cmd_lock);
+
+	return hit;
+}
+
+static void rt1320_shadow_put(struct rt1320_priv *rt1320, unsigned int id,
+	const void *buf, unsigned int size, unsigned int gen)
+{
+	struct rt1320_param_shadow *sh;
+
+	if (id >= RT1320_PARAM_SHADOW_IDS || !(rt1320_param_shadowed & BIT(id)) ||
+	    size > RT1320_PARAM_SHADOW_SIZE)
+		return;
+
+	sh = &rt1320->shadow[id];
+	spin_lock(&rt1320->cmd_lock);
+	if (gen == rt1320->shadow_gen) {
+		memcpy(sh->data, buf, size);
+		sh->size = max(sh->size, size);
+	}
+	spin_unlock(&rt1320->cmd_lock);
+}
+
+static void rt1320_shadow_invalidate(struct rt1320_priv *rt1320)
+{
+	int i;
+
+	spin_lock(&rt1320->cmd_lock);
+	rt1320->shadow_gen++;
+	for (i = 0; i < RT1320_PARAM_SHADOW_IDS; i++)
+		rt1320->shadow[i].size = 0;
+	spin_unlock(&rt1320->cmd_lock);
+}
+
 static int rt1320_load_dsp_fw(struct rt1320_priv *rt1320, unsigned char action)
 {
 	struct regmap *regmap = rt1320->regmap;
 	struct device *dev = regmap_get_device(regmap);
-	const struct firmware *firmware;
-	int ret, i;
+	int ret;
 	unsigned short rs_gain[2] = {0};
-	bool dump_fw = (action == 2 || action == 3) ? true : false;
-	bool compare = (action == 3) ? true : false;
 
-	printk("%s(%d) FW update start. \n", __func__, __LINE__);
+#ifndef RT1320_I2C_FW_WR
+	ret = rt1320_spi_attach(rt1320, dev);
+	if (ret) {
+		dev_err(dev, "%s: no SPI companion: %d\n", __func__, ret);
+		return ret;
+	}
+#endif
+
+	dev_dbg(dev, "%s: FW update start\n", __func__);
+	rt1320_shadow_invalidate(rt1320);
 	regmap_update_bits(rt1320->regmap, 0xf01e, 0x1, 0x1); // let DSP stall
 	regmap_update_bits(rt1320->regmap, 0xf01e, (0x1 << 7), (0x0 << 7));
 
-	if (log_fp)
-		kernel_write(log_fp, "RT1320 DSP FW update start\n", 27, &log_pos);
-
-	ret = request_firmware(&firmware, "rt1320/0x3fc000c0.dat", dev);
-	if (ret == 0) {
-		dev_info(dev, "%s: FW_0x3fc000c0 size=0x%x\n", __func__, firmware->size);
-		rt1320_fw_param_write(rt1320, 0x3fc000c0, firmware->data, firmware->size);
-		if (action == 2 || action == 3) {
-			if (rt1320_dsp_fw_check(rt1320, 0x3fc000c0, firmware->data, firmware->size, dump_fw, compare))
-				pr_err("%s: 0x3fc000c0 %s failed!\n",
-					__func__, action == 2 ? "dump" : "update");
-			else
-				pr_err("%s: 0x3fc000c0 %s succeeded!\n",
-					__func__, action == 2 ? "dump" : "update");
-		}
-		release_firmware(firmware);
-	} else
-		dev_err(dev, "%s: Failed to get firmware 0x3fc000c0\n", __func__);
-
-	ret = request_firmware(&firmware, "rt1320/0x3fc29d80.dat", dev);
-	if (ret == 0) {
-		dev_info(dev, "%s: FW_0x3fc29d80 size=0x%x\n", __func__, firmware->size);
-		rt1320_fw_param_write(rt1320, 0x3fc29d80, firmware->data, firmware->size);
-		if (action == 2 || action == 3) {
-			if (rt1320_dsp_fw_check(rt1320, 0x3fc29d80, firmware->data, firmware->size, dump_fw, compare))
-				pr_err("%s: 0x3fc29d80 %s failed!\n",
-					__func__, action == 2 ? "dump" : "update");
-			else
-				pr_err("%s: 0x3fc29d80 %s succeeded!\n",
-					__func__, action == 2 ? "dump" : "update");
-		}
-		release_firmware(firmware);
-	} else
-		dev_err(dev, "%s: Failed to get firmware 0x3fc29d80\n", __func__);
-
-	ret = request_firmware(&firmware, "rt1320/0x3fe00000.dat", dev);
-	if (ret == 0) {
-		dev_info(dev, "%s: FW_0x3fe00000 size=0x%x\n", __func__, firmware->size);
-		rt1320_fw_param_write(rt1320, 0x3fe00000, firmware->data, firmware->size);
-		if (action == 2 || action == 3) {
-			if (rt1320_dsp_fw_check(rt1320, 0x3fe00000, firmware->data, firmware->size, dump_fw, compare))
-				pr_err("%s: 0x3fe00000 %s failed!\n",
-					__func__, action == 2 ? "dump" : "update");
-			else
-				pr_err("%s: 0x3fe00000 %s succeeded!\n",
-					__func__, action == 2 ? "dump" : "update");
-		}
-		release_firmware(firmware);
-	} else
-		dev_err(dev, "%s: Failed to get firmware 0x3fe00000\n", __func__);
-
-	ret = request_firmware(&firmware, "rt1320/0x3fe02000.dat", dev);
-	if (ret == 0) {
-		dev_info(dev, "%s: FW_0x3fe02000 size=0x%x\n", __func__, firmware->size);
-		rt1320_fw_param_write(rt1320, 0x3fe02000, firmware->data, firmware->size);
-		if (action == 2 || action == 3) {
-			if (rt1320_dsp_fw_check(rt1320, 0x3fe02000, firmware->data, firmware->size, dump_fw, compare))
-				pr_err("%s: 0x3fe02000 %s failed!\n",
-					__func__, action == 2 ? "dump" : "update");
-			else
-				pr_err("%s: 0x3fe02000 %s succeeded!\n",
-					__func__, action == 2 ? "dump" : "update");
-		}
-		release_firmware(firmware);
-	} else
-		dev_err(dev, "%s: Failed to get firmware 0x3fe02000\n", __func__);
+#ifndef RT1320_I2C_FW_WR
+	ret = rt1320_spi_selftest(rt1320->spi, RT1320_DSP_SCRATCH_ADDR,
+		RT1320_DSP_SCRATCH_SIZE);
+	if (ret)
+		dev_warn(dev, "%s: SPI self-test failed: %d\n", __func__, ret);
+#endif
+
+	ret = rt1320_load_fw_segs(rt1320, rt1320_dsp_segs,
+		ARRAY_SIZE(rt1320_dsp_segs), action);
+	if (ret)
+		dev_err(dev, "%s: DSP firmware segments incomplete: %d\n", __func__, ret);
 
-	msleep(1000);
 	// for (i = 0; i < 4; i++) {
 	// 	regmap_write(rt1320->regmap, 0x3fc2bfc7 - i, 0x00);
 	// 	regmap_write(rt1320->regmap, 0x3fc2bfcb - i, 0x00);
@@ -757,87 +1244,358 @@ static int rt1320_load_dsp_fw(struct rt1320_priv *rt1320, unsigned char action)
 
 	// for (i = 0; i < 4; i++)
 	// 	regmap_write(rt1320->regmap, 0x3fc2bfc3 - i, ((i == 3) ? 0x0b : 0x00) );
-	msleep(1000);
 	regmap_write(rt1320->regmap, 0x3fc2bfc0, 0x0b);
 
-	printk("%s(%d) FW update end. \n", __func__, __LINE__);
-	if (log_fp)
-		kernel_write(log_fp, "RT1320 DSP FW update end\n", 25, &log_pos);
+	dev_dbg(dev, "%s: FW update end\n", __func__);
+	rt1320_shadow_invalidate(rt1320);
 
 	rt1320->fw_update = true;
 	regmap_update_bits(rt1320->regmap, 0xc081, 0x3, 0x2); // set DSP clk from RC
 	regmap_update_bits(rt1320->regmap, 0xf01e, 0x1, 0x0); // let DSP run
 
-	return 0;
+	return rt1320_wait_dsp_ready(rt1320);
 }
 
-static int rt1320_i2c_read(void *context, unsigned int reg, unsigned int *val)
+/*
+ * Register bus. Codec control registers always go over I2C. When the SPI
+ * companion is bound, the DSP memory window and bulk transfers beyond the
+ * control space of at least RT1320_SPI_BULK_MIN bytes use the SPI 32-bit
+ * and burst commands instead, so callers keep using plain regmap APIs.
+ */
+#define RT1320_DSP_MEM_START	0x3fc00000
+#define RT1320_DSP_MEM_END	0x3fe3b000
+#define RT1320_SPI_BULK_MIN	32
+
+static bool rt1320_bus_use_spi(struct rt1320_priv *rt1320, unsigned int reg,
+	size_t len)
 {
-	struct i2c_client *client = context;
-	struct rt1320_priv *rt1320 = i2c_get_clientdata(client);
-	struct regmap *regmap_phy = rt1320->regmap_physical;
-	struct device *dev = &client->dev;
-	char log_str[32] = {0};
+	if (!rt1320->spi)
+		return false;
+
+	if (reg >= RT1320_DSP_MEM_START && reg + len <= RT1320_DSP_MEM_END)
+		return true;
 
-	if (rt1320_readable_register(dev, reg)) {
-		regmap_read(regmap_phy, reg, val);
-		if (log_fp && !IS_ERR(log_fp)) {
-			sprintf(log_str, "%08X => %02X", reg, *val);
-			log_fp_write(log_str, strlen(log_str));
+	return reg > 0xffff && len >= RT1320_SPI_BULK_MIN;
+}
+
+static int rt1320_spi_bus_write(struct rt1320_priv *rt1320, unsigned int reg,
+	const u8 *val, size_t len)
+{
+	struct rt1320_spi *rspi = rt1320->spi;
+	unsigned int word, shift, i;
+	size_t n;
+	int ret = 0;
+
+	while (len && !ret) {
+		if (!(reg % 8) && len >= 8) {
+			/* the burst pads to whole words, so only send whole words */
+			n = round_down(len, 8);
+			ret = rt1320_spi_burst_write(rspi, reg, val, n);
+		} else if (!(reg % 4) && len >= 4) {
+			n = 4;
+			ret = rt1320_spi_write_addr(rspi, reg, get_unaligned_le32(val));
+		} else {
+			/* partial word, read-modify-write */
+			shift = reg % 4;
+			n = min_t(size_t, 4 - shift, len);
+			ret = rt1320_spi_read_addr(rspi, reg & ~3, &word);
+			if (ret)
+				break;
+			for (i = 0; i < n; i++) {
+				word &= ~(0xffu << (8 * (shift + i)));
+				word |= (u32)val[i] << (8 * (shift + i));
+			}
+			ret = rt1320_spi_write_addr(rspi, reg & ~3, word);
 		}
-	} else
-		dev_err(dev, "Not readable register %x\n", reg);
+		reg += n;
+		val += n;
+		len -= n;
+	}
 
-	return 0;
+	return ret;
 }
 
-static int rt1320_i2c_write(void *context, unsigned int reg, unsigned int val)
+static int rt1320_spi_bus_read(struct rt1320_priv *rt1320, unsigned int reg,
+	u8 *val, size_t len)
 {
-	struct i2c_client *client = context;
-	struct rt1320_priv *rt1320 = i2c_get_clientdata(client);
-	struct regmap *regmap_phy = rt1320->regmap_physical;
-	struct device *dev = &client->dev;
+	struct rt1320_spi *rspi = rt1320->spi;
+	unsigned int start, end, word, i;
+	u8 *buf;
 	int ret;
-	char buf[17];
-
-	// dev_info(dev, "%s, write reg %x, val %x\n", __func__, reg, val);
-	ret = regmap_write(regmap_phy, reg, val);
-	if (!ret) {
-		memset(buf, 0, sizeof(buf));
-		snprintf(buf, sizeof(buf), "WrL1 %08X %02X", reg, val);
-		buf[sizeof(buf)-1] = '\n';
-		if (log_fp && !IS_ERR(log_fp)) {
-			ret = kernel_write(log_fp, &buf, sizeof(buf), &log_pos);
-			if (ret < 0)
-				dev_err(dev, "write file %s failed: %d\n", log_path, ret);
+
+	/* within one word */
+	if (reg / 4 == (reg + len - 1) / 4) {
+		ret = rt1320_spi_read_addr(rspi, reg & ~3, &word);
+		for (i = 0; i < len; i++)
+			val[i] = word >> (8 * (reg % 4 + i));
+		return ret;
+	}
+
+	start = round_down(reg, 8);
+	end = round_up(reg + len, 8);
+	if (start == reg && end == reg + len)
+		return rt1320_spi_burst_read(rspi, reg, val, len);
+
+	buf = kmalloc(end - start, GFP_KERNEL);
+	if (!buf)
+		return -ENOMEM;
+
+	ret = rt1320_spi_burst_read(rspi, start, buf, end - start);
+	if (!ret)
+		memcpy(val, buf + reg - start, len);
+	kfree(buf);
+
+	return ret;
+}
+
+/*
+ * Register access trace. Accesses are recorded into a ring only while
+ * debugfs reg_trace is open, and the recording site is a static branch,
+ * so an unread trace costs nothing on the access path. Writers claim a
+ * slot with an atomic increment and publish it through its sequence
+ * number; a reader that finds a sequence number other than the one it
+ * expects has been overtaken and skips ahead.
+ */
+static DEFINE_STATIC_KEY_FALSE(rt1320_trace_on);
+
+static void __rt1320_trace_io(struct rt1320_priv *rt1320, bool write,
+	bool spi, unsigned int reg, const u8 *val, size_t len)
+{
+	struct rt1320_trace *trace;
+	struct rt1320_trace_ent *ent;
+	unsigned int seq;
+
+	rcu_read_lock();
+	trace = rcu_dereference(rt1320->trace);
+	if (!trace)
+		goto out;
+
+	seq = atomic_inc_return(&trace->head);
+	ent = &trace->ent[seq & (RT1320_TRACE_LEN - 1)];
+
+	WRITE_ONCE(ent->seq, 0);
+	smp_wmb();
+	ent->ts = ktime_get_ns();
+	ent->reg = reg;
+	ent->len = len;
+	ent->write = write;
+	ent->spi = spi;
+	ent->val = len ? val[0] : 0;
+	smp_store_release(&ent->seq, seq);
+out:
+	rcu_read_unlock();
+}
+
+static inline void rt1320_trace_io(struct rt1320_priv *rt1320, bool write,
+	bool spi, unsigned int reg, const u8 *val, size_t len)
+{
+	trace_rt1320_reg_io(&rt1320->i2c->dev, write, spi, reg, val, len);
+
+	if (static_branch_unlikely(&rt1320_trace_on))
+		__rt1320_trace_io(rt1320, write, spi, reg, val, len);
+}
+
+static int rt1320_i2c_bus_write(struct rt1320_priv *rt1320, const void *data,
+	size_t count)
+{
+	int ret;
+
+	ret = i2c_master_send(rt1320->i2c, data, count);
+	if (ret == count)
+		return 0;
+
+	return ret < 0 ? ret : -EIO;
+}
+
+static int rt1320_i2c_bus_read(struct rt1320_priv *rt1320, const void *reg_buf,
+	size_t reg_size, void *val, size_t len)
+{
+	struct i2c_client *client = rt1320->i2c;
+	struct i2c_msg xfer[2] = {
+		{
+			.addr = client->addr,
+			.len = reg_size,
+			.buf = (u8 *)reg_buf,
+		},
+		{
+			.addr = client->addr,
+			.flags = I2C_M_RD,
+			.len = len,
+			.buf = val,
+		},
+	};
+	int ret;
+
+	ret = i2c_transfer(client->adapter, xfer, ARRAY_SIZE(xfer));
+	if (ret == ARRAY_SIZE(xfer))
+		return 0;
+
+	return ret < 0 ? ret : -EIO;
+}
+
+static int rt1320_bus_write(void *context, const void *data, size_t count)
+{
+	struct rt1320_priv *rt1320 = context;
+	unsigned int reg = get_unaligned_be32(data);
+	bool spi = rt1320_bus_use_spi(rt1320, reg, count - 4);
+	int ret;
+
+	if (spi)
+		ret = rt1320_spi_bus_write(rt1320, reg, data + 4, count - 4);
+	else
+		ret = rt1320_i2c_bus_write(rt1320, data, count);
+
+	if (!ret)
+		rt1320_trace_io(rt1320, true, spi, reg, data + 4, count - 4);
+
+	return ret;
+}
+
+/* I2C payloads are linearised by the regmap core through .write */
+static int rt1320_bus_gather_write(void *context, const void *reg_buf,
+	size_t reg_size, const void *val_buf, size_t val_size)
+{
+	struct rt1320_priv *rt1320 = context;
+	unsigned int reg = get_unaligned_be32(reg_buf);
+	int ret;
+
+	if (!rt1320_bus_use_spi(rt1320, reg, val_size))
+		return -ENOTSUPP;
+
+	ret = rt1320_spi_bus_write(rt1320, reg, val_buf, val_size);
+	if (!ret)
+		rt1320_trace_io(rt1320, true, true, reg, val_buf, val_size);
+
+	return ret;
+}
+
+static int rt1320_bus_read(void *context, const void *reg_buf, size_t reg_size,
+	void *val_buf, size_t val_size)
+{
+	struct rt1320_priv *rt1320 = context;
+	unsigned int reg = get_unaligned_be32(reg_buf);
+	bool spi = rt1320_bus_use_spi(rt1320, reg, val_size);
+	int ret;
+
+	if (spi)
+		ret = rt1320_spi_bus_read(rt1320, reg, val_buf, val_size);
+	else
+		ret = rt1320_i2c_bus_read(rt1320, reg_buf, reg_size, val_buf, val_size);
+
+	if (!ret)
+		rt1320_trace_io(rt1320, false, spi, reg, val_buf, val_size);
+
+	return ret;
+}
+
+static const struct regmap_bus rt1320_bus = {
+	.write = rt1320_bus_write,
+	.gather_write = rt1320_bus_gather_write,
+	.read = rt1320_bus_read,
+	.reg_format_endian_default = REGMAP_ENDIAN_BIG,
+	.val_format_endian_default = REGMAP_ENDIAN_NATIVE,
+};
+
+/*
+ * Private registers (PR) are reached through the indirect window at
+ * 0xc480: command bytes at 0xc480..0xc483, the PR address at
+ * 0xc484..0xc487, write data at 0xc488..0xc48b and read data at
+ * 0xc48c..0xc48f, all little endian. Setting bit 7 of 0xc482 starts the
+ * access; bit 6 selects a read.
+ *
+ * The command bytes are volatile, so every access programs the full
+ * command and address block. The upper three bytes of each go out as
+ * auto-increment runs, 0xc484 and then 0xc480 are written last on their
+ * own so the low bytes still land after the rest of the block, and the
+ * result comes back as one read.
+ */
+#define RT1320_PR_CMD		0xc480
+#define RT1320_PR_ADDR		0xc484
+#define RT1320_PR_WDATA		0xc488
+#define RT1320_PR_RDATA		0xc48c
+#define RT1320_PR_CTRL		0xc482
+#define RT1320_PR_GO		0x80
+#define RT1320_PR_RD		0x40
+
+static int rt1320_pr_access(struct rt1320_priv *rt1320, struct reg_default *prs,
+	int num, bool write)
+{
+	const u8 cmd[4] = { 0x10, 0x0c, write ? 0x00 : RT1320_PR_RD, 0x80 };
+	u8 addr[4], data[4];
+	int i, ret;
+
+	for (i = 0; i < num; i++) {
+		put_unaligned_le32(prs[i].reg, addr);
+
+		ret = regmap_raw_write(rt1320->regmap, RT1320_PR_CMD + 1,
+			&cmd[1], 3);
+		if (ret)
+			return ret;
+		ret = regmap_raw_write(rt1320->regmap, RT1320_PR_ADDR + 1,
+			&addr[1], 3);
+		if (ret)
+			return ret;
+		ret = regmap_write(rt1320->regmap, RT1320_PR_ADDR, addr[0]);
+		if (ret)
+			return ret;
+		ret = regmap_write(rt1320->regmap, RT1320_PR_CMD, cmd[0]);
+		if (ret)
+			return ret;
+
+		if (write) {
+			put_unaligned_le32(prs[i].def, data);
+			ret = regmap_raw_write(rt1320->regmap, RT1320_PR_WDATA,
+				data, sizeof(data));
+			if (ret)
+				return ret;
+		}
+
+		ret = regmap_write(rt1320->regmap, RT1320_PR_CTRL,
+			RT1320_PR_GO | (write ? 0 : RT1320_PR_RD));
+		if (ret)
+			return ret;
+
+		if (!write) {
+			ret = regmap_raw_read(rt1320->regmap, RT1320_PR_RDATA,
+				data, sizeof(data));
+			if (ret)
+				return ret;
+			prs[i].def = get_unaligned_le32(data);
 		}
 	}
 
 	return 0;
 }
 
-static void rt1320_pr_read(struct rt1320_priv *rt1320, unsigned int reg, unsigned int *val)
+static int rt1320_pr_read_multi(struct rt1320_priv *rt1320, struct reg_default *prs, int num)
+{
+	return rt1320_pr_access(rt1320, prs, num, false);
+}
+
+static int __maybe_unused rt1320_pr_write_multi(struct rt1320_priv *rt1320,
+	const struct reg_default *prs, int num)
 {
-	unsigned int byte3, byte2, byte1, byte0;
+	return rt1320_pr_access(rt1320, (struct reg_default *)prs, num, true);
+}
 
-	regmap_write(rt1320->regmap, 0xc483, 0x80);
-	regmap_write(rt1320->regmap, 0xc482, 0x40);
-	regmap_write(rt1320->regmap, 0xc481, 0x0c);
-	regmap_write(rt1320->regmap, 0xc480, 0x10);
+static int __maybe_unused rt1320_pr_read(struct rt1320_priv *rt1320,
+	unsigned int reg, unsigned int *val)
+{
+	struct reg_default pr = { reg, 0 };
+	int ret;
 
-	regmap_write(rt1320->regmap, 0xc487, ((reg & 0xff000000)>>24));
-	regmap_write(rt1320->regmap, 0xc486, ((reg & 0x00ff0000)>>16));
-	regmap_write(rt1320->regmap, 0xc485, ((reg & 0x0000ff00)>>8));
-	regmap_write(rt1320->regmap, 0xc484, (reg & 0x000000ff));
+	ret = rt1320_pr_read_multi(rt1320, &pr, 1);
+	*val = pr.def;
 
-	regmap_write(rt1320->regmap, 0xc482, 0xc0);
+	return ret;
+}
 
-	regmap_read(rt1320->regmap, 0xc48f, &byte3);
-	regmap_read(rt1320->regmap, 0xc48e, &byte2);
-	regmap_read(rt1320->regmap, 0xc48d, &byte1);
-	regmap_read(rt1320->regmap, 0xc48c, &byte0);
+static int __maybe_unused rt1320_pr_write(struct rt1320_priv *rt1320,
+	unsigned int reg, unsigned int val)
+{
+	struct reg_default pr = { reg, val };
 
-	*val = (byte3 << 24) | (byte2 << 16) | (byte1 << 8) | byte0;
+	return rt1320_pr_write_multi(rt1320, &pr, 1);
 }
 
 static void rt1320_dump_regs(struct rt1320_priv *rt1320)
@@ -854,7 +1612,6 @@ static void rt1320_dump_regs(struct rt1320_priv *rt1320)
 	const char reg_dump_path[] = "/lib/firmware/rt1320/rt1320_regs_dump.txt";
 	loff_t pos = 0;
 	char buf[15];
-	char buf1[15];
 
 	dev_info(dev, "RT1320 dump registers\n");
 
@@ -881,15 +1638,6 @@ static void rt1320_dump_regs(struct rt1320_priv *rt1320)
 				if (ret < 0)
 					break;
 			}
-
-			if (log_fp && !IS_ERR(log_fp)) {
-				memset(buf1, 0, sizeof(buf1));
-				snprintf(buf1, sizeof(buf1), "%08X => %02X", regs[i], val);
-				buf1[sizeof(buf1)-1] = '\n';
-				ret = kernel_write(log_fp, &buf1, sizeof(buf1), &log_pos);
-				if (ret < 0)
-					dev_err(dev, "write to log file %s failed: %d\n", log_path, ret);
-			}
 		}
 	}
 	regcache_cache_bypass(rt1320->regmap, false);
@@ -937,6 +1685,10 @@ static int rt1320_dsp_fw_update_put(struct snd_kcontrol *kcontrol,
 		return 0;
 	}
 
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
+
 	if (action == 5) {
 		// set regs and run DSP
 		// regmap_update_bits(rt1320->regmap, 0xc081, 0x1 << 1, 0x0 << 1);
@@ -1027,24 +1779,93 @@ typedef enum {
 	RT1320_FW_READY,
 	RT1320_SET_PARAM,
 	RT1320_GET_PARAM,
+	RT1320_BATCH_PARAM,
 } rt1320_fw_cmdid;
 
+#define RT1320_FW_READY_TIMEOUT_US	550000
+
 static int rt1320_check_fw_ready(struct rt1320_priv *rt1320)
 {
-	unsigned int tmp, retry = 0;
+	int ret;
+
 	// check the value of RT1320_CMD_ID becomes to zero
-	while (retry < 50) {
-		regmap_read(rt1320->regmap, RT1320_CMD_ID, &tmp);
-		if (tmp == 0)
-			break;
-		usleep_range(10000, 11000);
-		retry++;
-	}
-	if (retry == 50) {
+	ret = rt1320_wait_reg(rt1320, &rt1320_wait_mbox, RT1320_CMD_ID, 0xff, 0,
+		RT1320_FW_READY_TIMEOUT_US);
+	if (ret == -ETIMEDOUT)
 		dev_warn(regmap_get_device(rt1320->regmap), "%s FW is NOT ready!", __func__);
-		return -ETIMEDOUT;
+
+	return ret;
+}
+
+/*
+ * Mailbox command. The parameter block (id, size, payload) goes out as one
+ * bulk write that also clears the rest of the area, the 8-byte command
+ * header as a second one with the command byte still zero, and the
+ * command byte is written last as the doorbell.
+ */
+#define RT1320_CMD_HDR_SIZE	8
+
+static int rt1320_mbox_post(struct rt1320_priv *rt1320, unsigned int cmdType,
+	const u8 *buf, unsigned int buf_size)
+{
+	u8 hdr[RT1320_CMD_HDR_SIZE] = { 0x01 }; // module ID
+	int ret;
+
+	ret = regmap_raw_write(rt1320->regmap, RT1320_CMD_PARAM_ADDR, buf, buf_size);
+	if (ret)
+		return ret;
+
+	put_unaligned_le32(buf_size, &hdr[4]);
+	ret = regmap_raw_write(rt1320->regmap, RT1320_FW_PARAM_ADDR, hdr, sizeof(hdr));
+	if (ret)
+		return ret;
+
+	return regmap_write(rt1320->regmap, RT1320_CMD_ID, cmdType);
+}
+
+static int rt1320_mbox_xfer(struct rt1320_priv *rt1320, unsigned int cmdType,
+	const u8 *buf, unsigned int buf_size)
+{
+	int ret;
+
+	ret = rt1320_mbox_post(rt1320, cmdType, buf, buf_size);
+	if (ret)
+		return ret;
+
+	return rt1320_check_fw_ready(rt1320);
+}
+
+/*
+ * DSP readiness handshake after a firmware update. Once the DSP has been
+ * released, a GET of one word of parameter block 0x06 is posted on the
+ * mailbox. The firmware clears RT1320_CMD_ID when it has taken the
+ * command, which it cannot do before it has booted. The result itself
+ * is not used.
+ */
+static unsigned int dsp_ready_timeout_ms = 1000;
+module_param(dsp_ready_timeout_ms, uint, 0644);
+MODULE_PARM_DESC(dsp_ready_timeout_ms, "Timeout for the DSP to answer the mailbox after a firmware update (ms)");
+
+static int rt1320_wait_dsp_ready(struct rt1320_priv *rt1320)
+{
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	u8 buf[RT1320_CMD_HDR_SIZE + 4] = { 0x06 };
+	ktime_t start = ktime_get();
+	int ret;
+
+	put_unaligned_le32(4, &buf[4]);
+	ret = rt1320_mbox_post(rt1320, RT1320_GET_PARAM, buf, sizeof(buf));
+	if (!ret)
+		ret = rt1320_wait_reg(rt1320, &rt1320_wait_default, RT1320_CMD_ID,
+			0xff, 0, dsp_ready_timeout_ms * USEC_PER_MSEC);
+	if (ret) {
+		dev_err(dev, "%s: DSP not ready: %d\n", __func__, ret);
+		return ret;
 	}
 
+	dev_dbg(dev, "%s: DSP ready after %lld us\n", __func__,
+		ktime_us_delta(ktime_get(), start));
+
 	return 0;
 }
 
@@ -1052,125 +1873,326 @@ static int rt1320_process_fw_param(struct rt1320_priv *rt1320, unsigned int cmdT
 				unsigned char *param_buf, unsigned int param_size)
 {
 	struct device *dev = regmap_get_device(rt1320->regmap);
-	int i, ret = 0;
-	unsigned int cmdhdr_size = 8;
-	unsigned int buf_size = param_size + cmdhdr_size;
-	unsigned char *buf = kmalloc(buf_size, GFP_KERNEL);
+	unsigned int buf_size = param_size + RT1320_CMD_HDR_SIZE;
+	unsigned int gen = READ_ONCE(rt1320->shadow_gen);
+	unsigned char *buf;
+	ktime_t t0 = ktime_get();
+	s64 us;
+	int ret;
+
+	if (cmdType == RT1320_GET_PARAM &&
+	    rt1320_shadow_get(rt1320, paramId, param_buf, param_size))
+		return 0;
+
+	buf = kzalloc(buf_size, GFP_KERNEL);
 	if (!buf) {
-		dev_err(dev, "%s: Failed to allocate memory for buf!\n", __func__);
 		ret = -ENOMEM;
 		goto __exit__;
 	}
-	memset(buf, 0, buf_size);
-
-	printk("%s: cmdType=%d, paramId=%d, param_size=%d\n", __func__, cmdType, paramId, param_size);
 
 	buf[0] = paramId;
-	buf[4] = param_size;
+	put_unaligned_le32(param_size, &buf[4]);
+	if (cmdType == RT1320_SET_PARAM)
+		memcpy(buf + RT1320_CMD_HDR_SIZE, param_buf, param_size);
 
-	// clear the parameters in the memory
-	for (i = 0; i < buf_size; i++)
-		regmap_write(rt1320->regmap, RT1320_CMD_PARAM_ADDR + i, 0);
-
-	if (cmdType == RT1320_SET_PARAM) {
-		memcpy(buf + cmdhdr_size, param_buf, param_size);
-		// dev_dbg(dev, "%s: buf[]=", __func__);
-		// for (i = 0; i < buf_size; i++)
-		// 	printk(" %02X", buf[i]);
-		// printk("\n");
-
-		for (i = 0; i < buf_size / 4; i++)
-			printk("%s SET: 0x%x : 0x%08x (%u)\n", __func__, RT1320_CMD_PARAM_ADDR + i * 4, *(unsigned int *)(buf + i * 4), *(unsigned int *)(buf + i * 4));
-		rt1320_fw_param_write(rt1320, RT1320_CMD_PARAM_ADDR, (u8 *)buf, buf_size);
-
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 4, buf_size);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 5, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 6, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 7, 0x00);
-
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR, 0x01); // module ID
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 1, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 2, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 3, 0x00);
-		regmap_write(rt1320->regmap, RT1320_CMD_ID, cmdType);
-		ret = rt1320_check_fw_ready(rt1320);
-		if (ret < 0) {
-			dev_err(dev, "%s: FW is NOT ready after setting param!\n", __func__);
+	ret = rt1320_mbox_xfer(rt1320, cmdType, buf, buf_size);
+	if (ret < 0) {
+		dev_err(dev, "%s: FW is NOT ready after %s param!\n", __func__,
+			cmdType == RT1320_SET_PARAM ? "setting" : "getting");
+		goto __exit__;
+	}
+
+	if (cmdType == RT1320_GET_PARAM) {
+		/* into the heap buffer, param_buf may be on the stack */
+		ret = regmap_raw_read(rt1320->regmap, RT1320_CMD_PARAM_ADDR + RT1320_CMD_HDR_SIZE,
+			buf + RT1320_CMD_HDR_SIZE, param_size);
+		if (ret)
 			goto __exit__;
+		memcpy(param_buf, buf + RT1320_CMD_HDR_SIZE, param_size);
+	}
+	rt1320_shadow_put(rt1320, paramId, param_buf, param_size, gen);
+
+__exit__:
+	us = ktime_us_delta(ktime_get(), t0);
+	rt1320_wait_account(&rt1320->mbox_hist, us, ret);
+	trace_rt1320_mbox(dev, cmdType, paramId, param_buf, param_size, us, ret);
+	kfree(buf);
+	return ret;
+}
+
+/*
+ * Batched mailbox command. RT1320_BATCH_PARAM carries several parameter
+ * records back to back, each with the usual 8-byte record header, the
+ * command in byte 1 and the payload padded to a word. The firmware
+ * answers the GET records in place. Without dsp_batch_cmd, for firmware
+ * that lacks the command, the records are sent one command each.
+ */
+static bool dsp_batch_cmd;
+module_param(dsp_batch_cmd, bool, 0644);
+MODULE_PARM_DESC(dsp_batch_cmd, "Send DSP parameter batches as one mailbox command (needs firmware support)");
+
+struct rt1320_param_rec {
+	unsigned int cmd;
+	unsigned int param_id;
+	void *buf;
+	unsigned int size;
+};
+
+#define RT1320_PARAM_REC_SIZE(size)	(RT1320_CMD_HDR_SIZE + ALIGN(size, 4))
+
+static int rt1320_process_fw_batch(struct rt1320_priv *rt1320,
+	const struct rt1320_param_rec *recs, int num)
+{
+	struct device *dev = regmap_get_device(rt1320->regmap);
+	unsigned int gen = READ_ONCE(rt1320->shadow_gen);
+	unsigned int buf_size = 0, off;
+	unsigned char *buf;
+	unsigned long *hit;
+	bool get = false;
+	ktime_t t0;
+	s64 us;
+	int i, ret;
+
+	if (!dsp_batch_cmd || num == 1) {
+		for (i = 0; i < num; i++) {
+			ret = rt1320_process_fw_param(rt1320, recs[i].cmd,
+				recs[i].param_id, recs[i].buf, recs[i].size);
+			if (ret < 0)
+				return ret;
 		}
+		return 0;
 	}
-	if (cmdType == RT1320_GET_PARAM) {
-		regmap_write(rt1320->regmap, RT1320_CMD_PARAM_ADDR, paramId);
-		regmap_write(rt1320->regmap, RT1320_CMD_PARAM_ADDR + 4, param_size);
 
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 4, buf_size);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 5, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 6, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 7, 0x00);
+	hit = bitmap_zalloc(num, GFP_KERNEL);
+	if (!hit)
+		return -ENOMEM;
+
+	// GETs answered by the shadow copies stay out of the batch
+	for (i = 0; i < num; i++) {
+		if (recs[i].cmd == RT1320_GET_PARAM &&
+		    rt1320_shadow_get(rt1320, recs[i].param_id, recs[i].buf, recs[i].size))
+			__set_bit(i, hit);
+		else
+			buf_size += RT1320_PARAM_REC_SIZE(recs[i].size);
+	}
 
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR, 0x01); // module ID
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 1, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 2, 0x00);
-		regmap_write(rt1320->regmap, RT1320_FW_PARAM_ADDR + 3, 0x00);
-		regmap_write(rt1320->regmap, RT1320_CMD_ID, cmdType);
+	if (!buf_size) {
+		bitmap_free(hit);
+		return 0;
+	}
 
-		ret = rt1320_check_fw_ready(rt1320);
-		if (ret < 0) {
-			dev_err(dev, "%s: FW is NOT ready before getting param!\n", __func__);
+	buf = kzalloc(buf_size, GFP_KERNEL);
+	if (!buf) {
+		bitmap_free(hit);
+		return -ENOMEM;
+	}
+
+	t0 = ktime_get();
+	for (off = 0, i = 0; i < num; i++) {
+		if (test_bit(i, hit))
+			continue;
+		buf[off] = recs[i].param_id;
+		buf[off + 1] = recs[i].cmd;
+		put_unaligned_le32(recs[i].size, &buf[off + 4]);
+		if (recs[i].cmd == RT1320_SET_PARAM)
+			memcpy(buf + off + RT1320_CMD_HDR_SIZE, recs[i].buf, recs[i].size);
+		else
+			get = true;
+		off += RT1320_PARAM_REC_SIZE(recs[i].size);
+	}
+
+	ret = rt1320_mbox_xfer(rt1320, RT1320_BATCH_PARAM, buf, buf_size);
+	if (ret < 0) {
+		dev_err(dev, "%s: FW is NOT ready after %d records!\n", __func__, num);
+		goto __exit__;
+	}
+
+	if (get) {
+		ret = regmap_raw_read(rt1320->regmap, RT1320_CMD_PARAM_ADDR, buf, buf_size);
+		if (ret)
 			goto __exit__;
-		}
-		rt1320_fw_param_read(rt1320, RT1320_CMD_PARAM_ADDR, (u8 *)buf, buf_size);
-		memcpy(param_buf, buf + cmdhdr_size, param_size);
+	}
 
-		for (i = 0; i < buf_size / 4; i++)
-			printk("%s GET: 0x%x : 0x%08x (%u)\n", __func__, RT1320_CMD_PARAM_ADDR + i * 4, *(unsigned int *)(buf + i * 4), *(unsigned int *)(buf + i * 4));
+	for (off = 0, i = 0; i < num; i++) {
+		if (test_bit(i, hit))
+			continue;
+		if (recs[i].cmd == RT1320_GET_PARAM)
+			memcpy(recs[i].buf, buf + off + RT1320_CMD_HDR_SIZE, recs[i].size);
+		rt1320_shadow_put(rt1320, recs[i].param_id, recs[i].buf,
+			recs[i].size, gen);
+		off += RT1320_PARAM_REC_SIZE(recs[i].size);
 	}
 
 __exit__:
+	us = ktime_us_delta(ktime_get(), t0);
+	rt1320_wait_account(&rt1320->mbox_hist, us, ret);
+	// the event's id is the number of records for a batch
+	trace_rt1320_mbox(dev, RT1320_BATCH_PARAM, num, buf, buf_size, us, ret);
 	kfree(buf);
+	bitmap_free(hit);
+	return ret;
+}
+
+/*
+ * DSP command queue. Mailbox commands are queued per device and run one at
+ * a time from cmd_work, so callers never sit on the mailbox themselves.
+ * rt1320_cmd_start() hands back a command to wait on with rt1320_cmd_wait(),
+ * which also frees it.
+ */
+struct rt1320_cmd {
+	struct list_head list;
+	unsigned int type;
+	unsigned int param_id;
+	unsigned int size;
+	int ret;
+	struct completion done;
+	const struct rt1320_param_rec *recs; /* RT1320_BATCH_PARAM, size records */
+	u8 buf[];
+};
+
+static void rt1320_cmd_work(struct work_struct *work)
+{
+	struct rt1320_priv *rt1320 = container_of(work, struct rt1320_priv,
+		cmd_work);
+	struct rt1320_cmd *cmd;
+
+	for (;;) {
+		spin_lock(&rt1320->cmd_lock);
+		cmd = list_first_entry_or_null(&rt1320->cmd_queue,
+			struct rt1320_cmd, list);
+		if (cmd)
+			list_del(&cmd->list);
+		spin_unlock(&rt1320->cmd_lock);
+		if (!cmd)
+			break;
+
+		if (cmd->type == RT1320_BATCH_PARAM)
+			cmd->ret = rt1320_process_fw_batch(rt1320, cmd->recs,
+				cmd->size);
+		else
+			cmd->ret = rt1320_process_fw_param(rt1320, cmd->type,
+				cmd->param_id, cmd->buf, cmd->size);
+
+		complete(&cmd->done);
+	}
+}
+
+static struct rt1320_cmd *rt1320_cmd_start(struct rt1320_priv *rt1320,
+	unsigned int type, unsigned int param_id, const void *data,
+	unsigned int size)
+{
+	struct rt1320_cmd *cmd;
+
+	cmd = kzalloc(struct_size(cmd, buf,
+		type == RT1320_BATCH_PARAM ? 0 : size), GFP_KERNEL);
+	if (!cmd)
+		return ERR_PTR(-ENOMEM);
+
+	cmd->type = type;
+	cmd->param_id = param_id;
+	cmd->size = size;
+	init_completion(&cmd->done);
+	if (type == RT1320_SET_PARAM)
+		memcpy(cmd->buf, data, size);
+	else if (type == RT1320_BATCH_PARAM)
+		cmd->recs = data;
+
+	spin_lock(&rt1320->cmd_lock);
+	if (rt1320->cmd_dead) {
+		spin_unlock(&rt1320->cmd_lock);
+		kfree(cmd);
+		return ERR_PTR(-ESHUTDOWN);
+	}
+	list_add_tail(&cmd->list, &rt1320->cmd_queue);
+	spin_unlock(&rt1320->cmd_lock);
+
+	queue_work(system_unbound_wq, &rt1320->cmd_work);
+
+	return cmd;
+}
+
+/* Waits for a command from rt1320_cmd_start() and frees it. */
+static int rt1320_cmd_wait(struct rt1320_cmd *cmd, void *data)
+{
+	int ret;
+
+	if (IS_ERR(cmd))
+		return PTR_ERR(cmd);
+
+	wait_for_completion(&cmd->done);
+	ret = cmd->ret;
+	if (!ret && cmd->type == RT1320_GET_PARAM)
+		memcpy(data, cmd->buf, cmd->size);
+	kfree(cmd);
+
 	return ret;
 }
 
+static int rt1320_cmd_run_batch(struct rt1320_priv *rt1320,
+	const struct rt1320_param_rec *recs, int num)
+{
+	return rt1320_cmd_wait(rt1320_cmd_start(rt1320, RT1320_BATCH_PARAM, 0,
+		recs, num), NULL);
+}
+
+/*
+ * Refuses new commands and fails whatever is still queued with -ESHUTDOWN,
+ * then waits for the one the worker may have in flight.
+ */
+static void rt1320_cmd_shutdown(struct rt1320_priv *rt1320)
+{
+	struct rt1320_cmd *cmd, *tmp;
+	LIST_HEAD(list);
+
+	spin_lock(&rt1320->cmd_lock);
+	rt1320->cmd_dead = true;
+	list_splice_init(&rt1320->cmd_queue, &list);
+	spin_unlock(&rt1320->cmd_lock);
+
+	list_for_each_entry_safe(cmd, tmp, &list, list) {
+		list_del(&cmd->list);
+		cmd->ret = -ESHUTDOWN;
+		complete(&cmd->done);
+	}
+
+	flush_work(&rt1320->cmd_work);
+}
+
 static int rt1320_set_R0(struct rt1320_priv *rt1320, unsigned char *r0_data, int size)
 {
 	unsigned int params[2][8] = {0};
-	unsigned int paramId;
-	int i, ch, ret;
+	struct rt1320_param_rec recs[2];
+	int ch, ret;
 
 	if (size != 8) {
 		pr_err("%s: Invalid R0 data size! Need 8 bytes\n", __func__);
 		return -EINVAL;
 	}
 
-	for (ch = 0; ch < 2; ch++) {
-		if (ch == 0)
-			paramId = 0x06; // LCH
-		else
-			paramId = 0x07; // RCH
-
-		ret = rt1320_process_fw_param(rt1320, RT1320_GET_PARAM, paramId, (unsigned char *)params[ch], sizeof(params[ch]));
-		if (ret < 0) {
-			pr_err("%s: Failed to process FW param!\n", __func__);
-			return ret;
-		}
-
-		for (i = 0; i < ARRAY_SIZE(params[ch]); i++) {
-			printk("%s: %cch params[%d]=%08X\n", __func__, (ch == 0)? 'L':'R', i, params[ch][i]);
-		}
+	// paramId 0x06 is LCH, 0x07 is RCH
+	for (ch = 0; ch < 2; ch++)
+		recs[ch] = (struct rt1320_param_rec) {
+			RT1320_GET_PARAM, 0x06 + ch, params[ch], sizeof(params[ch])
+		};
+	ret = rt1320_cmd_run_batch(rt1320, recs, ARRAY_SIZE(recs));
+	if (ret < 0) {
+		pr_err("%s: Failed to process FW param!\n", __func__);
+		return ret;
+	}
 
+	for (ch = 0; ch < 2; ch++) {
 		// Modify the struct of params and Write them back
 		params[ch][0] = 0; // Enable channel protection
 		params[ch][1] = r0_data[0] | (r0_data[1] << 8) |
 				(r0_data[2] << 16) | (r0_data[3] << 24); // R0 value
-
-		ret = rt1320_process_fw_param(rt1320, RT1320_SET_PARAM, paramId,
-					(u8 *)params[ch], sizeof(params[ch]));
-		if (ret < 0) {
-			pr_err("%s: Failed to set ch%d R0 data!\n", __func__, ch);
-			return ret;
-		}
+		recs[ch].cmd = RT1320_SET_PARAM;
 	}
-	return 0;
+
+	ret = rt1320_cmd_run_batch(rt1320, recs, ARRAY_SIZE(recs));
+	if (ret < 0)
+		pr_err("%s: Failed to set R0 data!\n", __func__);
+
+	return ret;
 }
 
 static int rt1320_set_R0_get(struct snd_kcontrol *kcontrol,
@@ -1210,8 +2232,8 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 	int ch, ret, retry;
 	unsigned char r0_data[8] = {0}; // [0-3] = Lch R0 value, [4-7] = Rch R0 value
 	const char chn[2] = {'L', 'R'};
-	param params[NUM_READ_PARAM] = {0};
-	unsigned int param_id;
+	param params[2][NUM_READ_PARAM] = {0};
+	struct rt1320_param_rec recs[2];
 	unsigned int buf_size = 4 * NUM_READ_PARAM; // Param struct size in bytes
 	unsigned int vol_reg[4] = {0};
 	u32 re[2] = {0}, caliR0[2] = {0};
@@ -1223,13 +2245,17 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 		usleep_range(10000, 11000);
 	}
 
-	snd_soc_dapm_mutex_lock(&component->dapm);
+	if (rt1320_wait_preset(rt1320))
+		return;
+
 	if (!rt1320->fw_update) {
 		dev_err(component->dev, "DSP firmware is not updated yet!\n");
 		return;
 	}
+	trace_rt1320_calib(component->dev, "start", -1, 0);
 
-	// set volume 0dB
+	// set volume 0dB, only the volume change is done under the DAPM mutex
+	snd_soc_dapm_mutex_lock(&component->dapm);
 	regmap_read(rt1320->regmap, 0xdd0b, &vol_reg[3]);
 	regmap_read(rt1320->regmap, 0xdd0a, &vol_reg[2]);
 	regmap_read(rt1320->regmap, 0xdd09, &vol_reg[1]);
@@ -1238,28 +2264,30 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 	regmap_write(rt1320->regmap, 0xdd0a, 0xff);
 	regmap_write(rt1320->regmap, 0xdd09, 0x0f);
 	regmap_write(rt1320->regmap, 0xdd08, 0xff);
+	snd_soc_dapm_mutex_unlock(&component->dapm);
 
 	msleep(5000);
 
-	// Get MeanR0 and AdvanceGain values
+	// Get MeanR0 and AdvanceGain values, paramId 0x06 is LCH, 0x07 is RCH
+	for (ch = 0; ch < 2; ch++)
+		recs[ch] = (struct rt1320_param_rec) {
+			RT1320_GET_PARAM, 0x06 + ch, params[ch], buf_size
+		};
+	ret = rt1320_cmd_run_batch(rt1320, recs, ARRAY_SIZE(recs));
+	trace_rt1320_calib(component->dev, "mean_r0", -1, ret);
+	if (ret < 0) {
+		dev_err(component->dev, "Read params failed: %d\n", ret);
+		rt1320->calib_result = 0;
+		goto cali_exit;
+	}
+
 	for (ch = 0; ch < 2; ch++) {
-		if (ch == 0)
-			param_id = 0x06; // LCH
-		else
-			param_id = 0x07; // RCH
-		ret = rt1320_process_fw_param(rt1320, RT1320_GET_PARAM, param_id,
-						(unsigned char *)params, buf_size);
-		if (ret < 0) {
-			dev_err(component->dev, "%cch: Read params failed: %d\n", chn[ch], ret);
-			rt1320->calib_result = 0;
-			goto cali_exit;
-		}
-		rt1320->meanR0[ch] = params[2].u32 / factor; // Get the meanR0 value
+		rt1320->meanR0[ch] = params[ch][2].u32 / factor; // Get the meanR0 value
 		dev_dbg(component->dev, "%cch MeanR0: %02X %02X %02X %02X,(%u)\n",
-			chn[ch], params[2].u8[0], params[2].u8[1], params[2].u8[2], params[2].u8[3],
-			rt1320->meanR0[ch]);
+			chn[ch], params[ch][2].u8[0], params[ch][2].u8[1],
+			params[ch][2].u8[2], params[ch][2].u8[3], rt1320->meanR0[ch]);
 
-		rt1320->advGain[ch] = params[3].u32; // Get the advGain value
+		rt1320->advGain[ch] = params[ch][3].u32; // Get the advGain value
 		dev_dbg(component->dev, "%cch advance gain: %04X\n", chn[ch], rt1320->advGain[ch]);
 	}
 
@@ -1267,24 +2295,24 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 		dev_info(component->dev, "Quirk data is missing => Get R0 and calibrate\n");
 		// Get Re & CaliR0 values
 		for (retry = 0; retry < 1; retry++) { // loop for monitor R0
-			for (ch = 0; ch < 2; ch++) {
-				if (ch == 0)
-					param_id = 0x0b; // LCH
-				else
-					param_id = 0x0c; // RCH
+			// paramId 0x0b is LCH, 0x0c is RCH
+			for (ch = 0; ch < 2; ch++)
+				recs[ch] = (struct rt1320_param_rec) {
+					RT1320_GET_PARAM, 0x0b + ch, params[ch], buf_size
+				};
+			ret = rt1320_cmd_run_batch(rt1320, recs, ARRAY_SIZE(recs));
+			if (ret < 0) {
+				dev_err(component->dev, "Read param R0 failed: %d\n", ret);
+				rt1320->calib_result = 0;
+				goto cali_exit;
+			}
 
-				ret = rt1320_process_fw_param(rt1320, RT1320_GET_PARAM, param_id,
-						(unsigned char *)params, buf_size);
-				if (ret < 0) {
-					dev_err(component->dev, "%cch: Read param R0 failed: %d\n", chn[ch], ret);
-					rt1320->calib_result = 0;
-					goto cali_exit;
-				} else {
-					dev_info(component->dev, "%cch: Read param R0 succeeded. retry = %d\n", chn[ch], retry);
-					memcpy(r0_data + ch * 4, &params[4].u8[0], 4);
-				}
+			for (ch = 0; ch < 2; ch++) {
+				dev_info(component->dev, "%cch: Read param R0 succeeded. retry = %d\n", chn[ch], retry);
+				memcpy(r0_data + ch * 4, &params[ch][4].u8[0], 4);
 
 				ret = rt1320_calc_caliR0(rt1320, r0_data + ch * 4, sizeof(param), &re[ch], &caliR0[ch], ch);
+				trace_rt1320_calib(component->dev, "r0", ch, ret);
 				if (ret < 0) {
 					dev_err(component->dev, "%cch: Calculate CaliR0 failed: %d\n", chn[ch], ret);
 					rt1320->calib_result = 0;
@@ -1331,6 +2359,7 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 			dev_dbg(component->dev, "Use read-back R0 data to set R0\n");
 			ret = rt1320_set_R0(rt1320, r0_data, sizeof(r0_data));
 		}
+		trace_rt1320_calib(component->dev, "set_r0", -1, ret);
 		if (ret < 0) {
 			dev_err(component->dev, "Failed to set R0 data: %d\n", ret);
 			rt1320->calib_result = 0;
@@ -1340,20 +2369,33 @@ static void rt1320_calibrate(struct rt1320_priv *rt1320, u8 *quirk_data, int qui
 
 cali_exit:
 	// Restore volume
+	snd_soc_dapm_mutex_lock(&component->dapm);
 	regmap_write(rt1320->regmap, 0xdd0b, vol_reg[3]);
 	regmap_write(rt1320->regmap, 0xdd0a, vol_reg[2]);
 	regmap_write(rt1320->regmap, 0xdd09, vol_reg[1]);
 	regmap_write(rt1320->regmap, 0xdd08, vol_reg[0]);
+	snd_soc_dapm_mutex_unlock(&component->dapm);
 
+	trace_rt1320_calib(component->dev, "done", -1, rt1320->calib_result);
 	if (rt1320->calib_result > 0)
 		dev_info(component->dev, "RT1320 calibration done");
 	else
 		dev_err(component->dev, "RT1320 calibration failed");
+}
 
-	snd_soc_dapm_mutex_unlock(&component->dapm);
+/*
+ * Calibration takes seconds, so the controls only hand it to calib_work
+ * and return. The R0 data, if any, is picked up when the work runs.
+ */
+static void rt1320_calib_schedule(struct rt1320_priv *rt1320, const u8 *r0_data)
+{
+	spin_lock(&rt1320->cmd_lock);
+	rt1320->calib_quirk = r0_data;
+	if (r0_data)
+		memcpy(rt1320->calib_r0, r0_data, sizeof(rt1320->calib_r0));
+	spin_unlock(&rt1320->cmd_lock);
 
-	if (log_fp)
-		kernel_write(log_fp, "RT1320 get R0 end\n", 18, &log_pos);
+	queue_delayed_work(system_unbound_wq, &rt1320->calib_work, 0);
 }
 
 static int rt1320_set_R0_put(struct snd_kcontrol *kcontrol,
@@ -1371,7 +2413,7 @@ static int rt1320_set_R0_put(struct snd_kcontrol *kcontrol,
 	}
 	dev_dbg(component->dev, "\n");
 
-	rt1320_calibrate(rt1320, r0_data, ARRAY_SIZE(r0_data));
+	rt1320_calib_schedule(rt1320, r0_data);
 
 	return 0;
 }
@@ -1393,7 +2435,7 @@ static int rt1320_kR0_put(struct snd_kcontrol *kcontrol,
 		return 0;
 	}
 
-	rt1320_calibrate(rt1320, NULL, 0);
+	rt1320_calib_schedule(rt1320, NULL);
 
 	return 0;
 }
@@ -1431,6 +2473,11 @@ static int rt1320_post_dgain_put(struct snd_kcontrol *kcontrol,
 	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
 	struct soc_mixer_control *mc = (struct soc_mixer_control *)kcontrol->private_value;
 	unsigned int rval, val_inter = 0x10;
+	int ret;
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
 
 	dev_dbg(component->dev, "%s, L=%ld, R=%ld\n", __func__,
 		ucontrol->value.integer.value[0], ucontrol->value.integer.value[1]);
@@ -1459,6 +2506,11 @@ static int rt1320_lpk_put(struct snd_kcontrol *kcontrol,
 {
 	struct snd_soc_component *component = snd_kcontrol_chip(kcontrol);
 	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
+	int ret;
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
 
 	if (ucontrol->value.bytes.data[0])
 		regmap_write(rt1320->regmap, 0xc5d3, 0x09);
@@ -1472,7 +2524,8 @@ static const DECLARE_TLV_DB_SCALE(cae_tlv, -9525, 75, 0);
 
 static const struct snd_kcontrol_new rt1320_snd_controls[] = {
 
-	SOC_ENUM("DSP IB0 Sel", rt1320_dsp_ib0_enum),
+	SOC_ENUM_EXT("DSP IB0 Sel", rt1320_dsp_ib0_enum, snd_soc_get_enum_double,
+		rt1320_put_enum_double),
 	SOC_ENUM_EXT("DSP Path Select", rt1320_dac_data_enum, rt1320_dsp_path_get,
 		rt1320_dsp_path_put),
 	SND_SOC_BYTES_EXT("DSP FW Update", 1, rt1320_dsp_fw_update_get,
@@ -1483,14 +2536,14 @@ static const struct snd_kcontrol_new rt1320_snd_controls[] = {
 	SND_SOC_BYTES_EXT("RT1320 Get R0", 1, rt1320_kR0_get, rt1320_kR0_put),
 	SND_SOC_BYTES_EXT("RT1320 Set R0", 8, rt1320_set_R0_get, rt1320_set_R0_put),
 	SND_SOC_BYTES_EXT("Enable Loopback", 1, rt1320_lpk_get, rt1320_lpk_put),
-	SOC_SINGLE("MS R Switch", RT1320_CAE_R_CTRL, 7,
-		1, 1),
-	SOC_SINGLE("MS L Switch", RT1320_CAE_L_CTRL, 7,
-		1, 1),
-	SOC_SINGLE_TLV("MS R Volume", RT1320_CAE_R_CTRL,
-		0, 127, 0, cae_tlv),
-	SOC_SINGLE_TLV("MS L Volume", RT1320_CAE_L_CTRL,
-		0, 127, 0, cae_tlv),
+	SOC_SINGLE_EXT("MS R Switch", RT1320_CAE_R_CTRL, 7,
+		1, 1, snd_soc_get_volsw, rt1320_put_volsw),
+	SOC_SINGLE_EXT("MS L Switch", RT1320_CAE_L_CTRL, 7,
+		1, 1, snd_soc_get_volsw, rt1320_put_volsw),
+	SOC_SINGLE_EXT_TLV("MS R Volume", RT1320_CAE_R_CTRL,
+		0, 127, 0, snd_soc_get_volsw, rt1320_put_volsw, cae_tlv),
+	SOC_SINGLE_EXT_TLV("MS L Volume", RT1320_CAE_L_CTRL,
+		0, 127, 0, snd_soc_get_volsw, rt1320_put_volsw, cae_tlv),
 };
 
 static int rt1320_pdb_event(struct snd_soc_dapm_widget *w,
@@ -1499,6 +2552,13 @@ static int rt1320_pdb_event(struct snd_soc_dapm_widget *w,
 	struct snd_soc_component *component = snd_soc_dapm_to_component(w->dapm);
 	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
 	unsigned int val, val2;
+	ktime_t t0 = ktime_get();
+
+	/* startup waited for the preset, don't block with the DAPM mutex held */
+	if (event == SND_SOC_DAPM_PRE_PMU && !completion_done(&rt1320->preset_done)) {
+		dev_err(component->dev, "%s: bring-up not done\n", __func__);
+		return -EBUSY;
+	}
 
 	regmap_read(rt1320->regmap, 0xf01e, &val);
 
@@ -1523,6 +2583,8 @@ static int rt1320_pdb_event(struct snd_soc_dapm_widget *w,
 		break;
 	}
 
+	trace_rt1320_pdb(component->dev, event, ktime_us_delta(ktime_get(), t0));
+
 	return 0;
 }
 
@@ -1562,13 +2624,17 @@ static const struct snd_soc_dapm_route rt1320_dapm_routes[] = {
 static int rt1320_hw_params(struct snd_pcm_substream *substream,
 	struct snd_pcm_hw_params *params, struct snd_soc_dai *dai)
 {
-	// struct snd_soc_component *component = dai->component;
-	// struct rt1320_priv *rt1320 =
-	// 	snd_soc_component_get_drvdata(component);
-	// int retval;
+	struct snd_soc_component *component = dai->component;
+	struct rt1320_priv *rt1320 =
+		snd_soc_component_get_drvdata(component);
+	int ret;
 	// unsigned int sampling_rate;
 
 	dev_dbg(dai->dev, "%s %s", __func__, dai->name);
+
+	ret = rt1320_wait_preset(rt1320);
+	if (ret)
+		return ret;
 #if 0
 	/* sampling rate configuration */
 	switch (params_rate(params)) {
@@ -1613,6 +2679,8 @@ static int rt1320_hw_params(struct snd_pcm_substream *substream,
 	return 0;
 }
 
+static void rt1320_debugfs_init(struct rt1320_priv *rt1320);
+
 static int rt1320_component_probe(struct snd_soc_component *component)
 {
 	// int ret;
@@ -1621,15 +2689,28 @@ static int rt1320_component_probe(struct snd_soc_component *component)
 	rt1320->component = component;
 
 	dev_dbg(component->dev, "%s\n", __func__);
-	rt1320_vc_preset(rt1320);
+	rt1320_debugfs_init(rt1320);
+	rt1320->cmd_dead = false;
+	reinit_completion(&rt1320->preset_done);
+	queue_work(system_unbound_wq, &rt1320->preset_work);
 	// regmap_update_bits(rt1320->regmap, 0xf01e, (0x1 << 7), (0x1 << 7));
 
 	// rt1320_load_dsp_fw(rt1320, 3);
 	return 0;
 }
 
+static void rt1320_component_remove(struct snd_soc_component *component)
+{
+	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
+
+	flush_work(&rt1320->preset_work);
+	cancel_delayed_work_sync(&rt1320->calib_work);
+	rt1320_cmd_shutdown(rt1320);
+}
+
 static const struct snd_soc_component_driver soc_component_rt1320 = {
 	.probe = rt1320_component_probe,
+	.remove = rt1320_component_remove,
 	.controls = rt1320_snd_controls,
 	.num_controls = ARRAY_SIZE(rt1320_snd_controls),
 	.dapm_widgets = rt1320_dapm_widgets,
@@ -1643,11 +2724,11 @@ static int rt1320_startup(struct snd_pcm_substream *substream,
 	struct snd_soc_dai *dai)
 {
 	struct snd_soc_component *component = dai->component;
-	// struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
+	struct rt1320_priv *rt1320 = snd_soc_component_get_drvdata(component);
 
 	dev_dbg(component->dev, "%s %s\n", __func__, dai->name);
 
-	return 0;
+	return rt1320_wait_preset(rt1320);
 }
 
 static void rt1320_shutdown(struct snd_pcm_substream *substream,
@@ -1687,23 +2768,31 @@ static struct snd_soc_dai_driver rt1320_dai[] = {
 
 #define RT1320_REG_DISP_LEN 16
 static ssize_t rt1320_codec_show_range(struct rt1320_priv *rt1320,
-	char *buf, int start, int end)
+	char *buf, unsigned int start, unsigned int end)
 {
-	unsigned int val;
-	int cnt = 0, i;
-
-	for (i = start; i <= end; i++) {
-		if (cnt + RT1320_REG_DISP_LEN >= PAGE_SIZE)
+	const struct rt1320_reg_range *range;
+	unsigned int val, i;
+	int cnt = 0;
+
+	for (range = rt1320_reg_ranges;
+	     range < rt1320_reg_ranges + ARRAY_SIZE(rt1320_reg_ranges); range++) {
+		if (range->max < start)
+			continue;
+		if (range->min > end)
 			break;
+		if (!(range->flags & RT1320_REG_RD))
+			continue;
 
-		if (rt1320_readable_register(NULL, i)) {
-			regmap_read(rt1320->regmap, i, &val);
+		for (i = max(range->min, start); i <= min(range->max, end); i++) {
+			if (cnt + RT1320_REG_DISP_LEN >= PAGE_SIZE)
+				goto out;
 
+			regmap_read(rt1320->regmap, i, &val);
 			cnt += snprintf(buf + cnt, RT1320_REG_DISP_LEN,
 					"%08x: %02x\n", i, val);
 		}
 	}
-
+out:
 	if (cnt >= PAGE_SIZE)
 		cnt = PAGE_SIZE - 1;
 
@@ -1785,16 +2874,203 @@ static ssize_t rt1320_dsp_store(struct device *dev,
 }
 static DEVICE_ATTR(dsp, 0444, rt1320_dsp_show, rt1320_dsp_store);
 
-static const struct regmap_config rt1320_regmap_physical = {
-	.name = "physical",
-	.reg_bits = 32,
-	.val_bits = 8,
-	.readable_reg = rt1320_readable_register,
-	.max_register = 0x41181880,
-	.cache_type = REGCACHE_NONE,
-	.use_single_rw = true,
+#ifdef CONFIG_DEBUG_FS
+static void rt1320_hist_show(struct seq_file *s, struct rt1320_wait_hist *hist)
+{
+	int i;
+
+	for (i = 0; i < RT1320_WAIT_HIST_LEN - 1; i++)
+		seq_printf(s, "<%u us: %d\n", rt1320_wait_hist_us[i],
+			atomic_read(&hist->count[i]));
+	seq_printf(s, ">=%u us: %d\n", rt1320_wait_hist_us[i - 1],
+		atomic_read(&hist->count[i]));
+	seq_printf(s, "timeouts: %d\n", atomic_read(&hist->timeouts));
+}
+
+static int rt1320_wait_hist_show(struct seq_file *s, void *data)
+{
+	struct rt1320_priv *rt1320 = s->private;
+
+	rt1320_hist_show(s, &rt1320->wait_hist);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(rt1320_wait_hist);
+
+/* Mailbox round trips, from the parameter write to the firmware's answer */
+static int rt1320_mbox_hist_show(struct seq_file *s, void *data)
+{
+	struct rt1320_priv *rt1320 = s->private;
+
+	rt1320_hist_show(s, &rt1320->mbox_hist);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(rt1320_mbox_hist);
+
+#define RT1320_TRACE_POLL_MS	100
+
+static int rt1320_reg_trace_open(struct inode *inode, struct file *file)
+{
+	struct rt1320_priv *rt1320 = inode->i_private;
+	struct rt1320_trace *trace;
+
+	trace = vzalloc(sizeof(*trace));
+	if (!trace)
+		return -ENOMEM;
+
+	/* one reader at a time */
+	if (cmpxchg((struct rt1320_trace __force **)&rt1320->trace, NULL, trace)) {
+		vfree(trace);
+		return -EBUSY;
+	}
+
+	file->private_data = trace;
+	static_branch_inc(&rt1320_trace_on);
+
+	return nonseekable_open(inode, file);
+}
+
+static int rt1320_reg_trace_release(struct inode *inode, struct file *file)
+{
+	struct rt1320_priv *rt1320 = inode->i_private;
+
+	static_branch_dec(&rt1320_trace_on);
+	rcu_assign_pointer(rt1320->trace, NULL);
+	synchronize_rcu();
+	vfree(file->private_data);
+
+	return 0;
+}
+
+/*
+ * Copy out entry @seq. Returns -EAGAIN while it is still being written and
+ * -ENOENT once the writers have reused its slot.
+ */
+static int rt1320_trace_get(struct rt1320_trace *trace, unsigned int seq,
+	struct rt1320_trace_ent *out)
+{
+	struct rt1320_trace_ent *ent = &trace->ent[seq & (RT1320_TRACE_LEN - 1)];
+	unsigned int cur;
+
+	cur = smp_load_acquire(&ent->seq);
+	if (cur != seq)
+		return (!cur || (int)(cur - seq) < 0) ? -EAGAIN : -ENOENT;
+
+	*out = *ent;
+	smp_rmb();
+
+	return READ_ONCE(ent->seq) == seq ? 0 : -ENOENT;
+}
+
+static ssize_t rt1320_reg_trace_read(struct file *file, char __user *ubuf,
+	size_t count, loff_t *ppos)
+{
+	struct rt1320_trace *trace = file->private_data;
+	struct rt1320_trace_ent ent;
+	unsigned int head, seq;
+	char line[64];
+	size_t done = 0;
+	u64 ts;
+	u32 us;
+	int len, ret;
+
+	for (;;) {
+		head = atomic_read(&trace->head);
+
+		/* overtaken by the writers, drop what was lost */
+		if (head - trace->tail > RT1320_TRACE_LEN)
+			trace->tail = head - RT1320_TRACE_LEN;
+
+		while (trace->tail != head) {
+			seq = trace->tail + 1;
+			ret = rt1320_trace_get(trace, seq, &ent);
+			if (ret == -EAGAIN)
+				break;
+			if (ret) {
+				trace->tail = seq;
+				continue;
+			}
+
+			ts = ent.ts;
+			us = do_div(ts, NSEC_PER_SEC) / NSEC_PER_USEC;
+			if (ent.len == 1)
+				len = scnprintf(line, sizeof(line), "%5llu.%06u %c %s %08x %02x\n",
+					ts, us, ent.write ? 'W' : 'R', ent.spi ? "spi" : "i2c",
+					ent.reg, ent.val);
+			else
+				len = scnprintf(line, sizeof(line), "%5llu.%06u %c %s %08x +%u\n",
+					ts, us, ent.write ? 'W' : 'R', ent.spi ? "spi" : "i2c",
+					ent.reg, ent.len);
+			if (done + len > count)
+				return done ? done : -EINVAL;
+			if (copy_to_user(ubuf + done, line, len))
+				return done ? done : -EFAULT;
+			done += len;
+			trace->tail = seq;
+		}
+
+		if (done)
+			return done;
+		if (file->f_flags & O_NONBLOCK)
+			return -EAGAIN;
+		if (msleep_interruptible(RT1320_TRACE_POLL_MS))
+			return -EINTR;
+	}
+}
+
+static const struct file_operations rt1320_reg_trace_fops = {
+	.owner = THIS_MODULE,
+	.open = rt1320_reg_trace_open,
+	.release = rt1320_reg_trace_release,
+	.read = rt1320_reg_trace_read,
+	.llseek = no_llseek,
 };
 
+/* Cached registers come in contiguous blocks of unsigned long each */
+static int rt1320_regcache_show(struct seq_file *s, void *data)
+{
+	struct rt1320_priv *rt1320 = s->private;
+	unsigned int reg, regs = 0, blocks = 0;
+	bool prev = false, cached;
+
+	for (reg = 0; reg <= RT1320_CTRL_MAX; reg++) {
+		cached = regcache_reg_cached(rt1320->regmap, reg);
+		if (cached) {
+			regs++;
+			if (!prev)
+				blocks++;
+		}
+		prev = cached;
+	}
+
+	seq_printf(s, "registers: %u\n", regs);
+	seq_printf(s, "blocks: %u\n", blocks);
+	seq_printf(s, "data bytes: %zu\n", regs * sizeof(unsigned long));
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(rt1320_regcache);
+
+static void rt1320_debugfs_init(struct rt1320_priv *rt1320)
+{
+	struct dentry *root = rt1320->component->debugfs_root;
+
+	debugfs_create_file("wait_hist", 0444, root, rt1320,
+		&rt1320_wait_hist_fops);
+	debugfs_create_file("mbox_hist", 0444, root, rt1320,
+		&rt1320_mbox_hist_fops);
+	debugfs_create_file("reg_trace", 0400, root, rt1320,
+		&rt1320_reg_trace_fops);
+	debugfs_create_file("regcache", 0444, root, rt1320,
+		&rt1320_regcache_fops);
+}
+#else
+static inline void rt1320_debugfs_init(struct rt1320_priv *rt1320)
+{
+}
+#endif
+
 static const struct regmap_config rt1320_regmap = {
 	.reg_bits = 32,
 	.val_bits = 8,
@@ -1803,10 +3079,7 @@ static const struct regmap_config rt1320_regmap = {
 	.max_register = 0x41181880,
 	.reg_defaults = rt1320_regs,
 	.num_reg_defaults = ARRAY_SIZE(rt1320_regs),
-	.cache_type = REGCACHE_RBTREE,
-	.reg_write = rt1320_i2c_write,
-	.reg_read = rt1320_i2c_read,
-	.use_single_rw = true,
+	.cache_type = REGCACHE_MAPLE,
 };
 
 static const struct i2c_device_id rt1320_i2c_id[] = {
@@ -1833,13 +3106,23 @@ static void rt1320_calib_handler(struct work_struct *work)
 {
 	struct rt1320_priv *rt1320 = container_of(work, struct rt1320_priv,
 		calib_work.work);
+	u8 r0_data[sizeof(rt1320->calib_r0)];
+	bool quirk;
 
 	while (!rt1320->component->card->instantiated) {
 		pr_debug("%s\n", __func__);
 		usleep_range(10000, 15000);
 	}
 
-	// rt1320_calibrate(rt1320);
+	spin_lock(&rt1320->cmd_lock);
+	quirk = rt1320->calib_quirk;
+	memcpy(r0_data, rt1320->calib_r0, sizeof(r0_data));
+	spin_unlock(&rt1320->cmd_lock);
+
+	if (quirk)
+		rt1320_calibrate(rt1320, r0_data, sizeof(r0_data));
+	else
+		rt1320_calibrate(rt1320, NULL, 0);
 }
 
 static void rt1320_init(struct rt1320_priv *rt1320)
@@ -1870,24 +3153,17 @@ static int rt1320_i2c_probe(struct i2c_client *i2c)
 
 	i2c_set_clientdata(i2c, rt1320);
 
-	/* Regmap Initialization */
-	rt1320->regmap_physical = devm_regmap_init_i2c(i2c, &rt1320_regmap_physical);
-	if (IS_ERR(rt1320->regmap_physical))
-		return PTR_ERR(rt1320->regmap_physical);
-	dev_dbg(&i2c->dev, "regmap_physical initialized\n");
+	ret = rt1320_spi_attach(rt1320, &i2c->dev);
+	if (ret == -EPROBE_DEFER)
+		return ret;
 
-	rt1320->regmap = devm_regmap_init(&i2c->dev, NULL, i2c, &rt1320_regmap);
+	/* Regmap Initialization */
+	rt1320->i2c = i2c;
+	rt1320->regmap = devm_regmap_init(&i2c->dev, &rt1320_bus, rt1320, &rt1320_regmap);
 	if (IS_ERR(rt1320->regmap))
 		return PTR_ERR(rt1320->regmap);
 	dev_dbg(&i2c->dev, "regmap initialized\n");
 
-	log_fp = filp_open(log_path, O_WRONLY | O_CREAT, 0644);
-	if (IS_ERR(log_fp)) {
-		dev_err(&i2c->dev, "open file %s failed: %ld\n", log_path, PTR_ERR(log_fp));
-		return -EPROBE_DEFER;
-	} else
-		dev_info(&i2c->dev, "open file %s\n", log_path);
-
 	/* Reset */
 	regmap_write(rt1320->regmap, 0xc000, 0x03);
 
@@ -1923,6 +3199,11 @@ static int rt1320_i2c_probe(struct i2c_client *i2c)
 
 	rt1320_init(rt1320);
 	INIT_DELAYED_WORK(&rt1320->calib_work, rt1320_calib_handler);
+	INIT_WORK(&rt1320->preset_work, rt1320_preset_work);
+	INIT_WORK(&rt1320->cmd_work, rt1320_cmd_work);
+	INIT_LIST_HEAD(&rt1320->cmd_queue);
+	spin_lock_init(&rt1320->cmd_lock);
+	init_completion(&rt1320->preset_done);
 
 	regmap_read(rt1320->regmap, 0xc680, &val);
 
@@ -77,19 +77,86 @@
 #define RT1320_PDB_PIN_MNL_ON		0x1 << 0
 #define RT1320_PDB_PIN_MNL_OFF		0x0 << 0
 
+/*
+ * Packed bind-write stream (rt1320_bind_write_*_packed.h), generated from
+ * the reg_sequence tables by rt1320_pack_bind_write.py. Every record starts
+ * with an opcode byte, multi-byte fields are little endian:
+ *   RT1320_PACK_WRITE:		u32 base address, u16 length, <length> values
+ *   RT1320_PACK_DELAY:		u32 delay in us
+ *   RT1320_PACK_WAIT_MCU:	wait for RT1320_KR0_INT_READY
+ *   RT1320_PACK_LOAD_PATCH:	load the MCU patch code
+ */
+enum {
+	RT1320_PACK_WRITE,
+	RT1320_PACK_DELAY,
+	RT1320_PACK_WAIT_MCU,
+	RT1320_PACK_LOAD_PATCH,
+};
+
+/* Wait time histogram, bucket upper bounds are rt1320_wait_hist_us[] */
+#define RT1320_WAIT_HIST_LEN	8
+
+struct rt1320_wait_hist {
+	atomic_t count[RT1320_WAIT_HIST_LEN];
+	atomic_t timeouts;
+};
+
+/* Register access trace ring, see rt1320_trace_io() */
+#define RT1320_TRACE_LEN	4096	/* power of two */
+
+struct rt1320_trace_ent {
+	u64 ts;
+	unsigned int seq;
+	unsigned int reg;
+	unsigned int len;
+	bool write;
+	bool spi;
+	u8 val;
+};
+
+struct rt1320_trace {
+	atomic_t head;
+	unsigned int tail; /* reader only */
+	struct rt1320_trace_ent ent[RT1320_TRACE_LEN];
+};
+
+/* Host copies of DSP parameter blocks, see rt1320_shadow_get() */
+#define RT1320_PARAM_SHADOW_IDS		16
+#define RT1320_PARAM_SHADOW_SIZE	64
+
+struct rt1320_param_shadow {
+	unsigned int size; /* 0: not cached */
+	u8 data[RT1320_PARAM_SHADOW_SIZE];
+};
+
 struct rt1320_priv {
 	struct snd_soc_component *component;
-	struct regmap *regmap_physical;
+	struct i2c_client *i2c;
 	struct regmap *regmap;
 	unsigned int meanR0[2];
 	unsigned short advGain[2];
 	int version_id;
 	int calib_result; // 0: calibrate failed, 1: basic mode, 2: advance mode
 	struct delayed_work calib_work;
+	u8 calib_r0[8];
+	bool calib_quirk;
+	struct work_struct preset_work;
+	struct completion preset_done;
+	s64 preset_time_us;
+	struct rt1320_wait_hist wait_hist;
+	struct rt1320_wait_hist mbox_hist;
+	struct work_struct cmd_work;
+	struct list_head cmd_queue;
+	spinlock_t cmd_lock; /* cmd_queue, cmd_dead, calib_r0, calib_quirk, shadow */
+	bool cmd_dead;
+	struct rt1320_param_shadow shadow[RT1320_PARAM_SHADOW_IDS];
+	unsigned int shadow_gen;
 	bool bypass_dsp;
 	bool fu_dapm_mute;
 	bool fu_mixer_mute[4];
 	bool fw_update;
+	struct rt1320_spi *spi;
+	struct rt1320_trace __rcu *trace;
 };
 
 #endif /* __RT1320_H__ */
@@ -0,0 +1,353 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * rt1320_bind_write_333_20_packed.h -- packed RT1320 bind-write sequence
+ *
+ * Generated from rt1320_bind_write_333_20.h by rt1320_pack_bind_write.py.
+ * Do not edit, change the source table instead.
+ */
+
+#include <linux/types.h>
+
+static const u8 rt1320_bind_write_packed[] = {
+	/* 0x0000c570, 1 byte */
+	0x00, 0x70, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000c560, 1 byte */
+	0x00, 0x60, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000c000, 1 byte */
+	0x00, 0x00, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x03,
+	/* 0x0000c003, 1 byte */
+	0x00, 0x03, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xe0,
+	/* 0x0000e80a, 1 byte */
+	0x00, 0x0a, 0xe8, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000c01b, 1 byte */
+	0x00, 0x1b, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xfd,
+	/* 0x0000c5c3, 1 byte */
+	0x00, 0xc3, 0xc5, 0x00, 0x00, 0x01, 0x00, 0xf3,
+	/* 0x0000c5c2, 1 byte */
+	0x00, 0xc2, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x50,
+	/* 0x0000c5c6, 1 byte */
+	0x00, 0xc6, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x10,
+	/* 0x0000c5c4, 1 byte */
+	0x00, 0xc4, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x12,
+	/* 0x0000c5c8, 1 byte */
+	0x00, 0xc8, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x05,
+	/* 0x0000c5d8, 1 byte */
+	0x00, 0xd8, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x0a,
+	/* 0x0000dc20, 1 byte */
+	0x00, 0x20, 0xdc, 0x00, 0x00, 0x01, 0x00, 0x30,
+	/* 0x0000c582, 1 byte */
+	0x00, 0x82, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x01,
+	/* 0x0000c5d3, 1 byte */
+	0x00, 0xd3, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x0f,
+	/* 0x0000c58d, 1 byte */
+	0x00, 0x8d, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x11,
+	/* 0x0000c58c, 1 byte */
+	0x00, 0x8c, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x98,
+	/* 0x0000c057, 1 byte */
+	0x00, 0x57, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x51,
+	/* 0x0000c054, 1 byte */
+	0x00, 0x54, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x35,
+	/* 0x0000c053, 1 byte */
+	0x00, 0x53, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x55,
+	/* 0x0000c052, 1 byte */
+	0x00, 0x52, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x55,
+	/* 0x0000c051, 1 byte */
+	0x00, 0x51, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x13,
+	/* 0x0000c050, 1 byte */
+	0x00, 0x50, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x15,
+	/* 0x0000c060, 2 bytes */
+	0x00, 0x60, 0xc0, 0x00, 0x00, 0x02, 0x00, 0x99,
+	0x55,
+	/* 0x0000c063, 1 byte */
+	0x00, 0x63, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x55,
+	/* 0x0000c065, 1 byte */
+	0x00, 0x65, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xa5,
+	/* 0x0000c06b, 1 byte */
+	0x00, 0x6b, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x0a,
+	/* 0x0000ca05, 1 byte */
+	0x00, 0x05, 0xca, 0x00, 0x00, 0x01, 0x00, 0xd6,
+	/* 0x0000ca07, 1 byte */
+	0x00, 0x07, 0xca, 0x00, 0x00, 0x01, 0x00, 0x07,
+	/* 0x0000ca25, 1 byte */
+	0x00, 0x25, 0xca, 0x00, 0x00, 0x01, 0x00, 0xd6,
+	/* 0x0000ca27, 1 byte */
+	0x00, 0x27, 0xca, 0x00, 0x00, 0x01, 0x00, 0x07,
+	/* 0x0000cd00, 1 byte */
+	0x00, 0x00, 0xcd, 0x00, 0x00, 0x01, 0x00, 0x05,
+	/* 0x0000cf02, 1 byte */
+	0x00, 0x02, 0xcf, 0x00, 0x00, 0x01, 0x00, 0x0f,
+	/* 0x0000c604, 1 byte */
+	0x00, 0x04, 0xc6, 0x00, 0x00, 0x01, 0x00, 0x40,
+	/* 0x0000c609, 1 byte */
+	0x00, 0x09, 0xc6, 0x00, 0x00, 0x01, 0x00, 0x40,
+	/* 0x0000c600, 2 bytes */
+	0x00, 0x00, 0xc6, 0x00, 0x00, 0x02, 0x00, 0x05,
+	0x80,
+	/* 0x0000c046, 1 byte */
+	0x00, 0x46, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xfc,
+	/* 0x0000c045, 1 byte */
+	0x00, 0x45, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000c044, 1 byte */
+	0x00, 0x44, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000c043, 1 byte */
+	0x00, 0x43, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000c042, 1 byte */
+	0x00, 0x42, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000c041, 1 byte */
+	0x00, 0x41, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x7f,
+	/* 0x0000c040, 1 byte */
+	0x00, 0x40, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000cc10, 1 byte */
+	0x00, 0x10, 0xcc, 0x00, 0x00, 0x01, 0x00, 0x01,
+	/* 0x0000c700, 2 bytes */
+	0x00, 0x00, 0xc7, 0x00, 0x00, 0x02, 0x00, 0xf0,
+	0x13,
+	/* 0x0000c901, 1 byte */
+	0x00, 0x01, 0xc9, 0x00, 0x00, 0x01, 0x00, 0x04,
+	/* 0x0000c900, 1 byte */
+	0x00, 0x00, 0xc9, 0x00, 0x00, 0x01, 0x00, 0x73,
+	/* 0x0000ce31, 1 byte */
+	0x00, 0x31, 0xce, 0x00, 0x00, 0x01, 0x00, 0x0d,
+	/* 0x0000ce30, 1 byte */
+	0x00, 0x30, 0xce, 0x00, 0x00, 0x01, 0x00, 0xae,
+	/* 0x0000ce37, 1 byte */
+	0x00, 0x37, 0xce, 0x00, 0x00, 0x01, 0x00, 0x0b,
+	/* 0x0000ce36, 1 byte */
+	0x00, 0x36, 0xce, 0x00, 0x00, 0x01, 0x00, 0xd2,
+	/* 0x0000ce39, 1 byte */
+	0x00, 0x39, 0xce, 0x00, 0x00, 0x01, 0x00, 0x04,
+	/* 0x0000ce38, 1 byte */
+	0x00, 0x38, 0xce, 0x00, 0x00, 0x01, 0x00, 0x80,
+	/* 0x0000ce3f, 1 byte */
+	0x00, 0x3f, 0xce, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000ce3e, 1 byte */
+	0x00, 0x3e, 0xce, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000de03, 1 byte */
+	0x00, 0x03, 0xde, 0x00, 0x00, 0x01, 0x00, 0x05,
+	/* 0x0000c570, 1 byte */
+	0x00, 0x70, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x08,
+	/* 0x0000c086, 1 byte */
+	0x00, 0x86, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x02,
+	/* 0x0000c085, 1 byte */
+	0x00, 0x85, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x7f,
+	/* 0x0000c084, 1 byte */
+	0x00, 0x84, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000c081, 1 byte */
+	0x00, 0x81, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xfe,
+	/* 0x0000f084, 1 byte */
+	0x00, 0x84, 0xf0, 0x00, 0x00, 0x01, 0x00, 0x0f,
+	/* 0x0000f083, 1 byte */
+	0x00, 0x83, 0xf0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000f082, 1 byte */
+	0x00, 0x82, 0xf0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000f081, 1 byte */
+	0x00, 0x81, 0xf0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000f080, 1 byte */
+	0x00, 0x80, 0xf0, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000e801, 3 bytes */
+	0x00, 0x01, 0xe8, 0x00, 0x00, 0x03, 0x00, 0x01,
+	0xf8, 0xbe,
+	/* 0x0000c003, 1 byte */
+	0x00, 0x03, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xc0,
+	/* 0x0000c047, 1 byte */
+	0x00, 0x47, 0xc0, 0x00, 0x00, 0x01, 0x00, 0xc0,
+	/* 0x0000d470, 2 bytes */
+	0x00, 0x70, 0xd4, 0x00, 0x00, 0x02, 0x00, 0xec,
+	0x3a,
+	/* 0x0000d474, 2 bytes */
+	0x00, 0x74, 0xd4, 0x00, 0x00, 0x02, 0x00, 0x11,
+	0x32,
+	/* 0x0000d478, 3 bytes */
+	0x00, 0x78, 0xd4, 0x00, 0x00, 0x03, 0x00, 0x64,
+	0x20, 0x10,
+	/* 0x0000d47c, 1 byte */
+	0x00, 0x7c, 0xd4, 0x00, 0x00, 0x01, 0x00, 0xff,
+	/* 0x0000c019, 1 byte */
+	0x00, 0x19, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x10,
+	/* 0x0000d487, 1 byte */
+	0x00, 0x87, 0xd4, 0x00, 0x00, 0x01, 0x00, 0x0b,
+	/* 0x0000d487, 1 byte */
+	0x00, 0x87, 0xd4, 0x00, 0x00, 0x01, 0x00, 0x3b,
+	/* 0x0000d486, 1 byte */
+	0x00, 0x86, 0xd4, 0x00, 0x00, 0x01, 0x00, 0xc3,
+	/* load MCU patch */
+	0x03,
+	/* 0x3fc2bf83, 1 byte */
+	0x00, 0x83, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bf82, 1 byte */
+	0x00, 0x82, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bf81, 1 byte */
+	0x00, 0x81, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bf80, 1 byte */
+	0x00, 0x80, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc7, 1 byte */
+	0x00, 0xc7, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc6, 1 byte */
+	0x00, 0xc6, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc5, 1 byte */
+	0x00, 0xc5, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc4, 1 byte */
+	0x00, 0xc4, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc3, 1 byte */
+	0x00, 0xc3, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc2, 1 byte */
+	0x00, 0xc2, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc1, 1 byte */
+	0x00, 0xc1, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x00,
+	/* 0x3fc2bfc0, 1 byte */
+	0x00, 0xc0, 0xbf, 0xc2, 0x3f, 0x01, 0x00, 0x03,
+	/* 0x0000d486, 1 byte */
+	0x00, 0x86, 0xd4, 0x00, 0x00, 0x01, 0x00, 0x43,
+	/* wait for MCU ready */
+	0x02,
+	/* 0x1000db00, 26 bytes */
+	0x00, 0x00, 0xdb, 0x00, 0x10, 0x1a, 0x00, 0x05,
+	0x00, 0x11, 0x00, 0x00, 0x82, 0x04, 0xf1, 0x00,
+	0x00, 0x40, 0x02, 0xf2, 0x00, 0x00, 0xe0, 0x00,
+	0x10, 0x00, 0x00, 0x45, 0x0d, 0x01, 0x00, 0x00,
+	0x3f,
+	/* 0x0000d540, 1 byte */
+	0x00, 0x40, 0xd5, 0x00, 0x00, 0x01, 0x00, 0x21,
+	/* 0x41001988, 1 byte */
+	0x00, 0x88, 0x19, 0x00, 0x41, 0x01, 0x00, 0x00,
+	/* 0x41001388, 1 byte */
+	0x00, 0x88, 0x13, 0x00, 0x41, 0x01, 0x00, 0x00,
+	/* 0x41000189, 2 bytes */
+	0x00, 0x89, 0x01, 0x00, 0x41, 0x02, 0x00, 0x00,
+	0x00,
+	/* 0x40801508, 1 byte */
+	0x00, 0x08, 0x15, 0x80, 0x40, 0x01, 0x00, 0x00,
+	/* 0x40801588, 1 byte */
+	0x00, 0x88, 0x15, 0x80, 0x40, 0x01, 0x00, 0x00,
+	/* 0x40801809, 2 bytes */
+	0x00, 0x09, 0x18, 0x80, 0x40, 0x02, 0x00, 0x00,
+	0x00,
+	/* 0x40801909, 2 bytes */
+	0x00, 0x09, 0x19, 0x80, 0x40, 0x02, 0x00, 0x00,
+	0x00,
+	/* 0x410018c9, 1 byte */
+	0x00, 0xc9, 0x18, 0x00, 0x41, 0x01, 0x00, 0x01,
+	/* 0x410018a9, 1 byte */
+	0x00, 0xa9, 0x18, 0x00, 0x41, 0x01, 0x00, 0x01,
+	/* 0x41181880, 1 byte */
+	0x00, 0x80, 0x18, 0x18, 0x41, 0x01, 0x00, 0x00,
+	/* 0x0000c5fb, 1 byte */
+	0x00, 0xfb, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000c5c3, 1 byte */
+	0x00, 0xc3, 0xc5, 0x00, 0x00, 0x01, 0x00, 0xf3,
+	/* 0x0000c5c8, 1 byte */
+	0x00, 0xc8, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x05,
+	/* 0x0000dd08, 4 bytes */
+	0x00, 0x08, 0xdd, 0x00, 0x00, 0x04, 0x00, 0x53,
+	0x0f, 0x53, 0x0f,
+	/* 0x0000c5d3, 1 byte */
+	0x00, 0xd3, 0xc5, 0x00, 0x00, 0x01, 0x00, 0x05,
+	/* 0x0000c044, 1 byte */
+	0x00, 0x44, 0xc0, 0x00, 0x00, 0x01, 0x00, 0x1f,
+	/* 0x0000db03, 1 byte */
+	0x00, 0x03, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db08, 2 bytes */
+	0x00, 0x08, 0xdb, 0x00, 0x00, 0x02, 0x00, 0x7f,
+	0x00,
+	/* 0x0000db19, 1 byte */
+	0x00, 0x19, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db02, 1 byte */
+	0x00, 0x02, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x73,
+	/* 0x0000db01, 1 byte */
+	0x00, 0x01, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db04, 1 byte */
+	0x00, 0x04, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db07, 1 byte */
+	0x00, 0x07, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db00, 1 byte */
+	0x00, 0x00, 0xdb, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* 0x0000db05, 2 bytes */
+	0x00, 0x05, 0xdb, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00,
+	/* 0x0000db1a, 2 bytes */
+	0x00, 0x1a, 0xdb, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00,
+	/* 0x1000d600, 512 bytes */
+	0x00, 0x00, 0xd6, 0x00, 0x10, 0x00, 0x02, 0x10,
+	0xec, 0x13, 0x20, 0x00, 0x14, 0x00, 0xc8, 0x00,
+	0x2d, 0x00, 0x00, 0x07, 0x00, 0x28, 0x00, 0x1e,
+	0x07, 0x00, 0x23, 0x00, 0x3c, 0x07, 0x00, 0x1e,
+	0x00, 0x5a, 0x07, 0x00, 0x19, 0x00, 0x78, 0x07,
+	0x00, 0x14, 0x00, 0x96, 0x07, 0x00, 0x0f, 0x00,
+	0xb4, 0x07, 0x00, 0x0a, 0x00, 0xd2, 0x07, 0x00,
+	0x05, 0x00, 0xf0, 0x07, 0x02, 0x58, 0x00, 0x00,
+	0x07, 0x02, 0x8a, 0x00, 0x1e, 0x07, 0x02, 0xbc,
+	0x00, 0x3c, 0x07, 0x02, 0xee, 0x00, 0x5a, 0x07,
+	0x03, 0x20, 0x00, 0x78, 0x07, 0x03, 0x52, 0x00,
+	0x96, 0x07, 0x03, 0x84, 0x00, 0xb4, 0x07, 0x03,
+	0xb6, 0x00, 0xd2, 0x07, 0x03, 0xe8, 0x00, 0xf0,
+	0x07, 0x03, 0x00, 0x64, 0x00, 0x1e, 0x07, 0xff,
+	0x00, 0x64, 0xff, 0xc4, 0x07, 0x03, 0x00, 0x64,
+	0x00, 0x1e, 0x07, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0xff, 0x00, 0x64, 0x00, 0x1e, 0x07, 0x00,
+	0x14, 0x00, 0xc8, 0x00, 0x2d, 0x00, 0x00, 0x07,
+	0x00, 0x28, 0x00, 0x1e, 0x07, 0x00, 0x23, 0x00,
+	0x3c, 0x07, 0x00, 0x1e, 0x00, 0x5a, 0x07, 0x00,
+	0x19, 0x00, 0x78, 0x07, 0x00, 0x14, 0x00, 0x96,
+	0x07, 0x00, 0x0f, 0x00, 0xb4, 0x07, 0x00, 0x0a,
+	0x00, 0xd2, 0x07, 0x00, 0x05, 0x00, 0xf0, 0x07,
+	0x02, 0x58, 0x00, 0x00, 0x07, 0x02, 0x8a, 0x00,
+	0x1e, 0x07, 0x02, 0xbc, 0x00, 0x3c, 0x07, 0x02,
+	0xee, 0x00, 0x5a, 0x07, 0x03, 0x20, 0x00, 0x78,
+	0x07, 0x03, 0x52, 0x00, 0x96, 0x07, 0x03, 0x84,
+	0x00, 0xb4, 0x07, 0x03, 0xb6, 0x00, 0xd2, 0x07,
+	0x03, 0xe8, 0x00, 0xf0, 0x07, 0x03, 0x00, 0x64,
+	0x00, 0x1e, 0x07, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0x03, 0x00, 0x64, 0x00, 0x1e, 0x07, 0xff,
+	0x00, 0x64, 0xff, 0xc4, 0x07, 0xff, 0x00, 0x64,
+	0x00, 0x1e, 0x07, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0xff, 0x00, 0x64, 0x00, 0x3c, 0x07, 0xff,
+	0x00, 0x64, 0xff, 0xc4, 0x07, 0xff, 0x00, 0x64,
+	0x00, 0x3c, 0x07, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0x0f, 0x04, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0xff, 0x00, 0x64, 0x00, 0x3c, 0x07, 0xff,
+	0x00, 0x64, 0xff, 0xc4, 0x07, 0xff, 0x00, 0x64,
+	0x00, 0x3c, 0x07, 0xff, 0x00, 0x64, 0xff, 0xc4,
+	0x07, 0x0f, 0x04, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0x00, 0x00, 0xc0, 0x3f, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03,
+	/* 0x1000d000, 93 bytes */
+	0x00, 0x00, 0xd0, 0x00, 0x10, 0x5d, 0x00, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8,
+	0x03, 0xe8, 0x03, 0xe8, 0x03, 0xe8, 0x03, 0x00,
+	0x00, 0xc0, 0x3f, 0x02, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0x07, 0x00,
+};
+
+/* 828 table entries -> 766 writes in 120 transfers, 1608 bytes */
+#define RT1320_BIND_WRITE_PACKED_LEN ARRAY_SIZE(rt1320_bind_write_packed)
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0-only
+#
+# rt1320_pack_bind_write.py -- pack the RT1320 bind-write table
+#
+# Copyright(c) 2025 Realtek Semiconductor Corp.
+#
+# Turns the reg_sequence in rt1320_bind_write_333_20.h into the packed
+# stream replayed by rt1320_vc_preset():
+#
+#   - writes that repeat the value a register already holds since the last
+#     barrier are dropped (e.g. the repeated brown-out blocks and 0xc5c3)
+#   - consecutive addresses are merged into one record
+#   - the MCU-ready poll, the MCU patch load and per-entry delays become
+#     explicit records and act as barriers
+#
+# The record layout is described next to RT1320_PACK_WRITE in rt1320.h.
+# The build regenerates the header whenever the table or this script
+# changes:
+#
+#   quiet_cmd_rt1320_pack = GEN     $@
+#         cmd_rt1320_pack = $(PYTHON3) $(srctree)/$(src)/rt1320_pack_bind_write.py $< $@
+#
+#   $(obj)/rt1320_bind_write_333_20_packed.h: $(src)/rt1320_bind_write_333_20.h \
+#                                             $(src)/rt1320_pack_bind_write.py FORCE
+#         $(call if_changed,rt1320_pack)
+#
+# Usage: rt1320_pack_bind_write.py <rt1320_bind_write_xxx.h> <output.h>
+
+import os
+import re
+import sys
+
+PACK_WRITE = 0x00
+PACK_DELAY = 0x01
+PACK_WAIT_MCU = 0x02
+PACK_LOAD_PATCH = 0x03
+
+MAX_RUN = 0xffff
+
+ENTRY_RE = re.compile(r'^\s*\{\s*(0x[0-9a-fA-F]+)\s*,\s*(0x[0-9a-fA-F]+)\s*'
+                      r'(?:,\s*(\d+)\s*)?\}')
+
+# Writing the reset register clears every control register
+RESET_REG = 0x0000c000
+
+# Registers with side effects on write (strobes, self-clearing bits,
+# status) are always written, even with an unchanged value.
+NO_ELIDE = [
+    (0x00000100, 0x00000100),
+    (0x0000c044, 0x0000c044),
+    (0x0000c400, 0x0000c40b),
+    (0x0000c480, 0x0000c48f),
+    (0x0000c560, 0x0000c560),
+    (0x0000c570, 0x0000c570),
+    (0x0000c680, 0x0000c680),
+    (0x0000c900, 0x0000c900),
+    (0x0000d486, 0x0000d487),
+    (0x0000d540, 0x0000d540),
+    (0x0000f015, 0x0000f015),
+    (0x0000f01c, 0x0000f01f),
+]
+
+
+def is_wait_mcu(reg, val):
+    return reg == 0x1000db00 and val == 0x05
+
+
+def is_load_patch(reg, val):
+    return reg == 0x0000d486 and val == 0xc3
+
+
+def can_elide(reg):
+    # only plain control registers are deduplicated
+    if reg > 0xffff:
+        return False
+    return not any(lo <= reg <= hi for lo, hi in NO_ELIDE)
+
+
+def parse(path):
+    entries = []
+    in_table = False
+
+    with open(path) as f:
+        for line in f:
+            if not in_table:
+                in_table = 'rt1320_bind_write[]' in line
+                continue
+            if line.strip().startswith('};'):
+                break
+            m = ENTRY_RE.match(line)
+            if m:
+                entries.append((int(m.group(1), 16), int(m.group(2), 16),
+                                int(m.group(3) or 0)))
+
+    if not entries:
+        sys.exit('%s: no rt1320_bind_write entries found' % path)
+
+    return entries
+
+
+def dedup(entries):
+    """Return the (reg, val, delay, barrier_before, barrier_after) writes."""
+    shadow = {}
+    out = []
+
+    for reg, val, delay in entries:
+        wait = is_wait_mcu(reg, val)
+        if wait:
+            shadow.clear()
+
+        if not wait and not delay and can_elide(reg) and shadow.get(reg) == val:
+            continue
+
+        out.append((reg, val, delay, wait))
+
+        if reg == RESET_REG or delay or is_load_patch(reg, val):
+            shadow.clear()
+        elif can_elide(reg):
+            shadow[reg] = val
+
+    return out
+
+
+def pack(writes):
+    """Group writes into records; returns a list of (op, args) tuples."""
+    records = []
+    run = None
+
+    def flush():
+        nonlocal run
+        if run:
+            records.append((PACK_WRITE, run))
+            run = None
+
+    for reg, val, delay, wait in writes:
+        if wait:
+            flush()
+            records.append((PACK_WAIT_MCU, None))
+
+        if run and run[0] + len(run[1]) == reg and len(run[1]) < MAX_RUN:
+            run[1].append(val)
+        else:
+            flush()
+            run = (reg, [val])
+
+        if delay:
+            flush()
+            records.append((PACK_DELAY, delay))
+        if is_load_patch(reg, val):
+            flush()
+            records.append((PACK_LOAD_PATCH, None))
+
+    flush()
+
+    return records
+
+
+def le(val, size):
+    return [(val >> (8 * i)) & 0xff for i in range(size)]
+
+
+def emit(records, nr_in, nr_out, src, dst):
+    out = []
+    nbytes = 0
+    nwrites = 0
+
+    out.append('/* SPDX-License-Identifier: GPL-2.0-only */')
+    out.append('/*')
+    out.append(' * %s -- packed RT1320 bind-write sequence' % os.path.basename(dst))
+    out.append(' *')
+    out.append(' * Generated from %s by rt1320_pack_bind_write.py.' % os.path.basename(src))
+    out.append(' * Do not edit, change the source table instead.')
+    out.append(' */')
+    out.append('')
+    out.append('#include <linux/types.h>')
+    out.append('')
+    out.append('static const u8 rt1320_bind_write_packed[] = {')
+
+    for op, arg in records:
+        if op == PACK_WRITE:
+            reg, vals = arg
+            nwrites += 1
+            out.append('\t/* 0x%08x, %d byte%s */' % (reg, len(vals), '' if len(vals) == 1 else 's'))
+            data = [op] + le(reg, 4) + le(len(vals), 2) + vals
+        elif op == PACK_DELAY:
+            out.append('\t/* delay %d us */' % arg)
+            data = [op] + le(arg, 4)
+        elif op == PACK_WAIT_MCU:
+            out.append('\t/* wait for MCU ready */')
+            data = [op]
+        else:
+            out.append('\t/* load MCU patch */')
+            data = [op]
+
+        nbytes += len(data)
+        for i in range(0, len(data), 8):
+            out.append('\t' + ' '.join('0x%02x,' % b for b in data[i:i + 8]))
+
+    out.append('};')
+    out.append('')
+    out.append('/* %d table entries -> %d writes in %d transfers, %d bytes */' %
+               (nr_in, nr_out, nwrites, nbytes))
+    out.append('#define RT1320_BIND_WRITE_PACKED_LEN ARRAY_SIZE(rt1320_bind_write_packed)')
+    out.append('')
+
+    with open(dst, 'w') as f:
+        f.write('\n'.join(out))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: %s <bind_write.h> <packed.h>' % sys.argv[0])
+
+    entries = parse(sys.argv[1])
+    writes = dedup(entries)
+    emit(pack(writes), len(entries), len(writes), sys.argv[1], sys.argv[2])
+
+
+if __name__ == '__main__':
+    main()